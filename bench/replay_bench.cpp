@@ -0,0 +1,211 @@
+// Replay benchmark: records bot games the way SimThread does, then reports
+// file size, straight playback speed and keyframe seek time, and checks
+// that every seek lands on the same game as playing from the start.
+// The greedy bot turns almost every move and dies within minutes; the
+// cycle bot survives a full hour and grows a long snake, the worst case
+// for keyframe size.
+//
+// Build and run with: make bench
+
+#include "sim/replay.h"
+#include <chrono>
+#include <cstdio>
+
+static const uint32_t TICK_MS = 1;
+static const uint32_t MOVE_DELAY = 150;
+static const uint32_t MAX_GAME_MS = 60 * 60 * 1000;   // One hour of play at most
+
+static bool is_safe(const SnakeSim& sim, Direction direction) {
+    Segment head = sim.get_snake().get_head();
+    switch (direction) {
+        case DIR_UP: head.y--; break;
+        case DIR_DOWN: head.y++; break;
+        case DIR_LEFT: head.x--; break;
+        case DIR_RIGHT: head.x++; break;
+    }
+    return head.x >= 0 && head.x < GRID_WIDTH && head.y >= 0 && head.y < GRID_HEIGHT &&
+           !sim.get_snake().is_occupied(head.x, head.y);
+}
+
+// Greedy bot: heads for the food along the longer axis first, and turns
+// aside when the next cell is taken
+static Direction choose_direction(const SnakeSim& sim) {
+    const Segment& head = sim.get_snake().get_head();
+    const Food& food = sim.get_food();
+    Direction preferred[4];
+    int count = 0;
+    int dx = food.x - head.x;
+    int dy = food.y - head.y;
+    Direction horizontal = dx < 0 ? DIR_LEFT : DIR_RIGHT;
+    Direction vertical = dy < 0 ? DIR_UP : DIR_DOWN;
+    bool horizontal_first = (dx < 0 ? -dx : dx) >= (dy < 0 ? -dy : dy);
+    preferred[count++] = horizontal_first ? horizontal : vertical;
+    preferred[count++] = horizontal_first ? vertical : horizontal;
+    preferred[count++] = horizontal_first ? (vertical == DIR_UP ? DIR_DOWN : DIR_UP)
+                                          : (horizontal == DIR_LEFT ? DIR_RIGHT : DIR_LEFT);
+    preferred[count++] = horizontal_first ? (horizontal == DIR_LEFT ? DIR_RIGHT : DIR_LEFT)
+                                          : (vertical == DIR_UP ? DIR_DOWN : DIR_UP);
+    for (int i = 0; i < count; i++) {
+        if (is_safe(sim, preferred[i])) return preferred[i];
+    }
+    return sim.get_snake().direction;
+}
+
+// Position along a Hamiltonian cycle of the board: rows zigzag over
+// columns 1 and up, and column 0 leads from the last row back to the first
+static int cycle_index(int x, int y) {
+    const int row_length = GRID_WIDTH - 1;
+    if (x == 0) return GRID_HEIGHT * row_length + (GRID_HEIGHT - 1 - y);
+    return y * row_length + (y % 2 == 0 ? x - 1 : row_length - x);
+}
+
+static int cycle_distance(int from, int to) {
+    const int cells = GRID_WIDTH * GRID_HEIGHT;
+    return ((to - from) % cells + cells) % cells;
+}
+
+// Cycle bot: moves forward along the cycle, so the body always trails the
+// head in cycle order and the snake cannot trap itself. While the snake is
+// short it skips ahead towards the food, never past its own tail.
+static Direction choose_cycle_direction(const SnakeSim& sim) {
+    const Snake& snake = sim.get_snake();
+    const Segment& head = snake.get_head();
+    const Segment& tail = snake.get_tail();
+    const Food& food = sim.get_food();
+    int head_index = cycle_index(head.x, head.y);
+    int room = cycle_distance(head_index, cycle_index(tail.x, tail.y));
+    int food_index = food.active ? cycle_index(food.x, food.y) : head_index;
+    bool shortcuts = snake.get_length() < GRID_WIDTH * GRID_HEIGHT / 2;
+    
+    static const Direction directions[] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
+    Direction best = snake.direction;
+    int best_to_food = -1;
+    for (Direction direction : directions) {
+        if (!is_safe(sim, direction)) continue;
+        Segment next = head;
+        switch (direction) {
+            case DIR_UP: next.y--; break;
+            case DIR_DOWN: next.y++; break;
+            case DIR_LEFT: next.x--; break;
+            case DIR_RIGHT: next.x++; break;
+        }
+        int index = cycle_index(next.x, next.y);
+        int skip = cycle_distance(head_index, index);
+        bool allowed = skip == 1 || (shortcuts && skip < room - 8);
+        if (!allowed) continue;
+        
+        int to_food = cycle_distance(index, food_index);
+        if (best_to_food < 0 || to_food < best_to_food) {
+            best = direction;
+            best_to_food = to_food;
+        }
+    }
+    // Off the cycle (the starting body runs against it): any safe move
+    return best_to_food >= 0 ? best : choose_direction(sim);
+}
+
+typedef Direction (*Bot)(const SnakeSim& sim);
+
+// Plays one game, deciding once per move, and returns its replay file
+static std::string record_game(uint64_t seed, Bot bot, SnakeSim& sim) {
+    ReplayRecorder recorder;
+    sim.get_manual_clock().set(0);
+    sim.reset(MOVE_DELAY, seed);
+    recorder.begin(seed, MOVE_DELAY, TICK_MS);
+    
+    uint32_t decided_move = UINT32_MAX;
+    while (!sim.is_game_over() && sim.get_time() < MAX_GAME_MS) {
+        if (sim.get_last_move_time() != decided_move) {
+            decided_move = sim.get_last_move_time();
+            Direction direction = bot(sim);
+            if (sim.push_input(SimInput(direction))) {
+                recorder.record_input(sim.get_time(), direction);
+            }
+        }
+        sim.get_manual_clock().advance(TICK_MS);
+        sim.step(SimInput());
+        recorder.after_step(sim);
+    }
+    recorder.finish(sim);
+    return recorder.get_data();
+}
+
+static bool same_game(const SnakeSim& a, const SnakeSim& b) {
+    const Segment& head_a = a.get_snake().get_head();
+    const Segment& head_b = b.get_snake().get_head();
+    return a.get_time() == b.get_time() && a.get_score() == b.get_score() &&
+           a.get_snake().get_length() == b.get_snake().get_length() &&
+           head_a.x == head_b.x && head_a.y == head_b.y &&
+           a.get_food().x == b.get_food().x && a.get_food().y == b.get_food().y;
+}
+
+int main() {
+    struct BenchGame {
+        const char* bot_name;
+        Bot bot;
+        uint64_t seed;
+    };
+    const BenchGame games[] = {
+        {"greedy", choose_direction, 1},
+        {"greedy", choose_direction, 42},
+        {"greedy", choose_direction, 1234567},
+        {"cycle", choose_cycle_direction, 1},
+        {"cycle", choose_cycle_direction, 0x5eed}
+    };
+    const int seek_points = 32;
+    bool ok = true;
+    
+    std::printf("%7s %8s %8s %7s %8s %7s %9s %9s %12s %9s\n", "bot", "seed", "game s", "length",
+                "inputs", "keys", "bytes", "B/minute", "playback x", "seek us");
+    
+    for (const BenchGame& game : games) {
+        uint64_t seed = game.seed;
+        SnakeSim live;
+        std::string data = record_game(seed, game.bot, live);
+        
+        Replay replay;
+        if (!replay.parse(data) || !replay.complete) {
+            std::printf("%10llu: replay did not parse\n", static_cast<unsigned long long>(seed));
+            return 1;
+        }
+        
+        // Straight playback, as fast as it goes
+        ReplayPlayer player(replay);
+        auto start = std::chrono::steady_clock::now();
+        player.advance(replay.end_time);
+        auto end = std::chrono::steady_clock::now();
+        double playback_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (!same_game(player.get_sim(), live)) {
+            std::printf("%10llu: playback diverged from the recorded game\n", static_cast<unsigned long long>(seed));
+            ok = false;
+        }
+        
+        // Seeks in scrambled order against one player moving forward only
+        ReplayPlayer seeker(replay);
+        double seek_us = 0;
+        for (int i = 0; i < seek_points; i++) {
+            uint32_t time = static_cast<uint32_t>((static_cast<uint64_t>(i) * 7 % seek_points) * replay.end_time / seek_points);
+            ReplayPlayer reference(replay);
+            reference.advance(time);
+            
+            auto seek_start = std::chrono::steady_clock::now();
+            seeker.seek(time);
+            auto seek_end = std::chrono::steady_clock::now();
+            seek_us += std::chrono::duration<double, std::micro>(seek_end - seek_start).count();
+            
+            if (!same_game(seeker.get_sim(), reference.get_sim())) {
+                std::printf("%10llu: seek to %u ms diverged\n", static_cast<unsigned long long>(seed), time);
+                ok = false;
+            }
+        }
+        
+        double game_minutes = replay.end_time / 60000.0;
+        std::printf("%7s %8llu %8.1f %7d %8zu %7zu %9zu %9.0f %12.0f %9.1f\n",
+                    game.bot_name, static_cast<unsigned long long>(seed), replay.end_time / 1000.0,
+                    live.get_snake().get_length(), replay.inputs.size(), replay.keyframes.size(),
+                    data.size(), data.size() / game_minutes,
+                    replay.end_time / playback_ms, seek_us / seek_points);
+    }
+    
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// Simulation thread benchmark: runs SimThread the way the game does while
+// the main thread stands in for an expensive renderer, busy for a fixed
+// time per frame, optionally with every other core kept busy as well.
+// Reports how far moves ran behind their tick schedule under each load;
+// a steady simulation keeps the lag flat however slow the frames get.
+//
+// Needs SDL, unlike the other benchmarks. Build and run with: make bench-thread
+
+#include "sim_thread.h"
+#include <cstdio>
+#include <vector>
+
+static const uint32_t TICK_MS = 1;
+static const uint32_t MAX_CATCH_UP_MS = 250;
+static const uint32_t MOVE_DELAY = 100;
+static const uint32_t RUN_MS = 5000;     // Per load
+static const int STEER_MARGIN = 6;       // Cells from the walls, room for a turn seen two moves late
+
+static std::atomic<bool> spinners_quit(false);
+
+static void busy_wait(uint32_t ms) {
+    Uint64 until = SDL_GetPerformanceCounter() + SDL_GetPerformanceFrequency() * ms / 1000;
+    while (SDL_GetPerformanceCounter() < until) {}
+}
+
+static int spin(void*) {
+    while (!spinners_quit.load(std::memory_order_relaxed)) {}
+    return 0;
+}
+
+// Keeps the snake circling a rectangle inside the walls, so it lives for
+// the whole run without any look-ahead
+static Direction steer(const SimSnapshot& snapshot) {
+    const Segment& head = snapshot.get_snake().get_segment(0);
+    Direction direction = snapshot.get_snake().direction;
+    switch (direction) {
+        case DIR_RIGHT: return head.x >= GRID_WIDTH - 1 - STEER_MARGIN ? DIR_DOWN : direction;
+        case DIR_DOWN: return head.y >= GRID_HEIGHT - 1 - STEER_MARGIN ? DIR_LEFT : direction;
+        case DIR_LEFT: return head.x <= STEER_MARGIN ? DIR_UP : direction;
+        case DIR_UP: return head.y <= STEER_MARGIN ? DIR_RIGHT : direction;
+    }
+    return direction;
+}
+
+int main() {
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+        std::printf("SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    
+    struct Load {
+        uint32_t frame_ms;
+        int spinners;
+    };
+    std::vector<Load> loads = {{0, 0}, {16, 0}, {50, 0}, {200, 0}};
+    int other_cores = SDL_GetCPUCount() - 1;
+    if (other_cores > 0) {
+        loads.push_back({16, other_cores});
+        loads.push_back({200, other_cores});
+    }
+    
+    SimThread sim_thread(TICK_MS, MAX_CATCH_UP_MS);
+    if (!sim_thread.start()) {
+        std::printf("Could not start the simulation thread: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    
+    std::printf("%8s %8s %7s %7s %6s %10s %10s\n", "frame ms", "spinners", "frames", "moves", "late",
+                "avg lag us", "max lag us");
+    
+    for (const Load& load : loads) {
+        spinners_quit.store(false);
+        std::vector<SDL_Thread*> spinners;
+        for (int i = 0; i < load.spinners; i++) {
+            spinners.push_back(SDL_CreateThread(spin, "spinner", nullptr));
+        }
+        
+        sim_thread.reset(MOVE_DELAY, 1);
+        if (!sim_thread.wait_for_reset(1000)) {
+            std::printf("The simulation thread did not answer the reset\n");
+            return 1;
+        }
+        
+        // Frame loop: newest snapshot, a turn when one is due, then the render cost
+        Uint32 start = SDL_GetTicks();
+        Direction pushed = sim_thread.get_snapshot().get_snake().direction;
+        int frames = 0;
+        while (SDL_GetTicks() - start < RUN_MS && !sim_thread.get_snapshot().is_game_over()) {
+            sim_thread.acquire();
+            const SimSnapshot& snapshot = sim_thread.get_snapshot();
+            sim_thread.acknowledge_events(snapshot.first_event_seq + static_cast<uint32_t>(snapshot.events.size()));
+            
+            Direction direction = steer(snapshot);
+            if (direction != pushed) {
+                sim_thread.push_turn(direction, SDL_GetTicks());
+                pushed = direction;
+            }
+            busy_wait(load.frame_ms);
+            frames++;
+        }
+        sim_thread.acquire();
+        const SimSnapshot& snapshot = sim_thread.get_snapshot();
+        
+        spinners_quit.store(true);
+        for (SDL_Thread* spinner : spinners) {
+            if (spinner) SDL_WaitThread(spinner, nullptr);
+        }
+        
+        const TickTimingStats& ticks = snapshot.get_tick_timing();
+        std::printf("%8u %8d %7d %7u %6u %10.0f %10u%s\n", load.frame_ms, load.spinners, frames,
+                    ticks.ticks, ticks.late_ticks, ticks.get_average(), ticks.max_lag,
+                    snapshot.is_game_over() ? "  (snake died)" : "");
+    }
+    
+    sim_thread.stop();
+    SDL_Quit();
+    return 0;
+}
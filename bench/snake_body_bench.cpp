@@ -0,0 +1,94 @@
+// Snake body benchmark: ring buffer Snake vs the previous vector layout
+// that shifted every segment on each move.
+//
+// Build and run with: make bench
+
+#include "sim/snake.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Previous body layout, kept here as the baseline
+struct VectorSnakeBody {
+    std::vector<Segment> segments;
+    
+    explicit VectorSnakeBody(size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            segments.push_back({-static_cast<int>(i), 0});
+        }
+    }
+    
+    void move(Direction direction) {
+        for (int i = segments.size() - 1; i > 0; i--) {
+            segments[i] = segments[i - 1];
+        }
+        
+        switch (direction) {
+            case DIR_UP: segments[0].y--; break;
+            case DIR_DOWN: segments[0].y++; break;
+            case DIR_LEFT: segments[0].x--; break;
+            case DIR_RIGHT: segments[0].x++; break;
+        }
+    }
+    
+    const Segment& get_head() const { return segments[0]; }
+};
+
+// Clockwise square so the snake never turns back on itself
+static Direction direction_for_tick(long tick) {
+    static const Direction cycle[] = {DIR_RIGHT, DIR_DOWN, DIR_LEFT, DIR_UP};
+    return cycle[(tick / 16) % 4];
+}
+
+template <typename Body>
+static double time_moves(Body& body, long moves, long& checksum) {
+    auto start = std::chrono::steady_clock::now();
+    for (long tick = 0; tick < moves; tick++) {
+        body.move(direction_for_tick(tick));
+        checksum += body.get_head().x;
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / moves;
+}
+
+// Adapter so Snake::move matches the baseline signature
+struct RingSnakeBody {
+    Snake snake;
+    
+    explicit RingSnakeBody(size_t length) : snake(length) {
+        while (static_cast<size_t>(snake.get_length()) < length) {
+            snake.grow();
+        }
+    }
+    
+    void move(Direction direction) {
+        snake.change_direction(direction);
+        snake.move();
+    }
+    
+    const Segment& get_head() const { return snake.get_head(); }
+};
+
+int main() {
+    const size_t lengths[] = {3, 100, 1000, 100000};
+    long checksum = 0;
+    
+    std::printf("%10s %16s %16s %10s\n", "length", "vector ns/move", "ring ns/move", "speedup");
+    
+    for (size_t length : lengths) {
+        // Keep the baseline run short at large lengths, where each move is O(n)
+        long moves = length >= 100000 ? 2000 : 2000000;
+        
+        VectorSnakeBody vector_body(length);
+        RingSnakeBody ring_body(length);
+        
+        double vector_ns = time_moves(vector_body, moves, checksum);
+        double ring_ns = time_moves(ring_body, moves, checksum);
+        
+        std::printf("%10zu %16.1f %16.1f %9.1fx\n", length, vector_ns, ring_ns, vector_ns / ring_ns);
+    }
+    
+    // Printed so the compiler cannot drop the loops
+    std::printf("checksum: %ld\n", checksum);
+    return 0;
+}
@@ -1,11 +1,12 @@
 #include "achievements.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
-Achievement::Achievement(const std::string& name, const std::string& desc, 
-                        AchievementType type, int target)
-    : name(name), description(desc), type(type), target_value(target),
-      unlocked(false), progress(0) {}
+Achievement::Achievement(const std::string& key, const std::string& name, const std::string& desc,
+                         AchievementType type, int target)
+    : key(key), id(StatsJournal::make_id(key)), name(name), description(desc), type(type),
+      target_value(target), unlocked(false), progress(0) {}
 
 bool Achievement::check_progress(const GameStats& stats) {
     int old_progress = progress;
@@ -51,56 +52,55 @@ float Achievement::get_progress_percent() const {
 }
 
 // AchievementSystem implementation
-AchievementSystem::AchievementSystem() {
+AchievementSystem::AchievementSystem() : journal(nullptr) {
     init_achievements();
-    load_progress();
 }
 
 void AchievementSystem::init_achievements() {
     // Score-based achievements
-    achievements.emplace_back("First Steps", "Score your first 100 points", ACH_SCORE, 100);
-    achievements.emplace_back("Getting Good", "Reach 1,000 points", ACH_SCORE, 1000);
-    achievements.emplace_back("Snake Master", "Reach 5,000 points", ACH_SCORE, 5000);
-    achievements.emplace_back("Legend", "Reach 10,000 points", ACH_SCORE, 10000);
-    achievements.emplace_back("Godlike", "Reach 25,000 points", ACH_SCORE, 25000);
+    achievements.emplace_back("score_100", "First Steps", "Score your first 100 points", ACH_SCORE, 100);
+    achievements.emplace_back("score_1000", "Getting Good", "Reach 1,000 points", ACH_SCORE, 1000);
+    achievements.emplace_back("score_5000", "Snake Master", "Reach 5,000 points", ACH_SCORE, 5000);
+    achievements.emplace_back("score_10000", "Legend", "Reach 10,000 points", ACH_SCORE, 10000);
+    achievements.emplace_back("score_25000", "Godlike", "Reach 25,000 points", ACH_SCORE, 25000);
     
     // Length-based achievements  
-    achievements.emplace_back("Growing Up", "Reach length of 10", ACH_LENGTH, 10);
-    achievements.emplace_back("Big Snake", "Reach length of 25", ACH_LENGTH, 25);
-    achievements.emplace_back("Huge Snake", "Reach length of 50", ACH_LENGTH, 50);
-    achievements.emplace_back("Colossal", "Reach length of 100", ACH_LENGTH, 100);
+    achievements.emplace_back("length_10", "Growing Up", "Reach length of 10", ACH_LENGTH, 10);
+    achievements.emplace_back("length_25", "Big Snake", "Reach length of 25", ACH_LENGTH, 25);
+    achievements.emplace_back("length_50", "Huge Snake", "Reach length of 50", ACH_LENGTH, 50);
+    achievements.emplace_back("length_100", "Colossal", "Reach length of 100", ACH_LENGTH, 100);
     
     // Level-based achievements
-    achievements.emplace_back("Leveling Up", "Reach level 5", ACH_LEVEL, 5);
-    achievements.emplace_back("Experienced", "Reach level 10", ACH_LEVEL, 10);
-    achievements.emplace_back("Expert", "Reach level 20", ACH_LEVEL, 20);
-    achievements.emplace_back("Unstoppable", "Reach level 50", ACH_LEVEL, 50);
+    achievements.emplace_back("level_5", "Leveling Up", "Reach level 5", ACH_LEVEL, 5);
+    achievements.emplace_back("level_10", "Experienced", "Reach level 10", ACH_LEVEL, 10);
+    achievements.emplace_back("level_20", "Expert", "Reach level 20", ACH_LEVEL, 20);
+    achievements.emplace_back("level_50", "Unstoppable", "Reach level 50", ACH_LEVEL, 50);
     
     // Food-based achievements
-    achievements.emplace_back("Hungry", "Eat 50 foods", ACH_FOODS, 50);
-    achievements.emplace_back("Voracious", "Eat 200 foods", ACH_FOODS, 200);
-    achievements.emplace_back("Omnivore", "Eat 500 foods", ACH_FOODS, 500);
-    achievements.emplace_back("Foodie", "Eat 1000 foods", ACH_FOODS, 1000);
+    achievements.emplace_back("foods_50", "Hungry", "Eat 50 foods", ACH_FOODS, 50);
+    achievements.emplace_back("foods_200", "Voracious", "Eat 200 foods", ACH_FOODS, 200);
+    achievements.emplace_back("foods_500", "Omnivore", "Eat 500 foods", ACH_FOODS, 500);
+    achievements.emplace_back("foods_1000", "Foodie", "Eat 1000 foods", ACH_FOODS, 1000);
     
     // Special food achievements
-    achievements.emplace_back("Magic Taste", "Eat 10 special foods", ACH_SPECIAL_FOODS, 10);
-    achievements.emplace_back("Power Hunter", "Eat 50 special foods", ACH_SPECIAL_FOODS, 50);
-    achievements.emplace_back("Gourmet", "Eat 100 special foods", ACH_SPECIAL_FOODS, 100);
+    achievements.emplace_back("special_10", "Magic Taste", "Eat 10 special foods", ACH_SPECIAL_FOODS, 10);
+    achievements.emplace_back("special_50", "Power Hunter", "Eat 50 special foods", ACH_SPECIAL_FOODS, 50);
+    achievements.emplace_back("special_100", "Gourmet", "Eat 100 special foods", ACH_SPECIAL_FOODS, 100);
     
     // Play time achievements
-    achievements.emplace_back("Casual Player", "Play for 30 minutes", ACH_TIME_PLAYED, 30);
-    achievements.emplace_back("Dedicated", "Play for 2 hours", ACH_TIME_PLAYED, 120);
-    achievements.emplace_back("Addicted", "Play for 10 hours", ACH_TIME_PLAYED, 600);
+    achievements.emplace_back("time_30", "Casual Player", "Play for 30 minutes", ACH_TIME_PLAYED, 30);
+    achievements.emplace_back("time_120", "Dedicated", "Play for 2 hours", ACH_TIME_PLAYED, 120);
+    achievements.emplace_back("time_600", "Addicted", "Play for 10 hours", ACH_TIME_PLAYED, 600);
     
     // Combo achievements
-    achievements.emplace_back("Combo Starter", "Achieve 5x combo", ACH_COMBO, 5);
-    achievements.emplace_back("Combo Master", "Achieve 10x combo", ACH_COMBO, 10);
-    achievements.emplace_back("Combo God", "Achieve 15x combo", ACH_COMBO, 15);
+    achievements.emplace_back("combo_5", "Combo Starter", "Achieve 5x combo", ACH_COMBO, 5);
+    achievements.emplace_back("combo_10", "Combo Master", "Achieve 10x combo", ACH_COMBO, 10);
+    achievements.emplace_back("combo_15", "Combo God", "Achieve 15x combo", ACH_COMBO, 15);
     
     // Game count achievements
-    achievements.emplace_back("Persistent", "Play 10 games", ACH_GAMES_PLAYED, 10);
-    achievements.emplace_back("Determined", "Play 50 games", ACH_GAMES_PLAYED, 50);
-    achievements.emplace_back("Never Give Up", "Play 100 games", ACH_GAMES_PLAYED, 100);
+    achievements.emplace_back("games_10", "Persistent", "Play 10 games", ACH_GAMES_PLAYED, 10);
+    achievements.emplace_back("games_50", "Determined", "Play 50 games", ACH_GAMES_PLAYED, 50);
+    achievements.emplace_back("games_100", "Never Give Up", "Play 100 games", ACH_GAMES_PLAYED, 100);
 }
 
 std::vector<std::string> AchievementSystem::update(const GameStats& stats) {
@@ -109,46 +109,69 @@ std::vector<std::string> AchievementSystem::update(const GameStats& stats) {
     for (auto& achievement : achievements) {
         if (achievement.check_progress(stats)) {
             new_achievements.push_back(achievement.name);
+            if (journal) journal->append_unlock(achievement.id);
             std::cout << "🏆 Achievement Unlocked: " << achievement.name << std::endl;
             std::cout << "   " << achievement.description << std::endl;
         }
     }
     
-    if (!new_achievements.empty()) {
-        save_progress();
-    }
+    // Every game ends here, so this is where the totals get snapshotted
+    if (journal) journal->checkpoint(stats, get_unlocked_ids());
     
     return new_achievements;
 }
 
-void AchievementSystem::save_progress() {
-    std::ofstream file("achievements.dat");
-    if (!file.is_open()) return;
+void AchievementSystem::restore(const GameStats& stats, const std::vector<uint32_t>& unlocked_ids) {
+    retired_unlocks.clear();
+    for (auto& achievement : achievements) {
+        achievement.unlocked = false;
+    }
     
-    for (const auto& achievement : achievements) {
-        file << achievement.name << "|" 
-             << achievement.unlocked << "|" 
-             << achievement.progress << std::endl;
+    for (uint32_t id : unlocked_ids) {
+        bool found = false;
+        for (auto& achievement : achievements) {
+            if (achievement.id == id) {
+                achievement.unlocked = true;
+                found = true;
+            }
+        }
+        if (!found && std::find(retired_unlocks.begin(), retired_unlocks.end(), id) == retired_unlocks.end()) {
+            retired_unlocks.push_back(id);
+        }
+    }
+    
+    // Progress only; anything newly reached is announced by the next update()
+    for (auto& achievement : achievements) {
+        bool was_unlocked = achievement.unlocked;
+        achievement.check_progress(stats);
+        achievement.unlocked = was_unlocked;
     }
 }
 
-void AchievementSystem::load_progress() {
+void AchievementSystem::import_legacy_progress(const GameStats& stats) {
+    std::vector<uint32_t> unlocked_ids;
     std::ifstream file("achievements.dat");
-    if (!file.is_open()) return;
-    
     std::string line;
-    size_t index = 0;
-    
-    while (std::getline(file, line) && index < achievements.size()) {
+    while (file.is_open() && std::getline(file, line)) {
         size_t pos1 = line.find('|');
         size_t pos2 = line.find('|', pos1 + 1);
+        if (pos1 == std::string::npos || pos2 == std::string::npos) continue;
+        if (line.substr(pos1 + 1, pos2 - pos1 - 1) != "1") continue;
         
-        if (pos1 != std::string::npos && pos2 != std::string::npos) {
-            achievements[index].unlocked = (line.substr(pos1 + 1, pos2 - pos1 - 1) == "1");
-            achievements[index].progress = std::stoi(line.substr(pos2 + 1));
+        std::string name = line.substr(0, pos1);
+        for (const auto& achievement : achievements) {
+            if (achievement.name == name) unlocked_ids.push_back(achievement.id);
         }
-        index++;
     }
+    restore(stats, unlocked_ids);
+}
+
+std::vector<uint32_t> AchievementSystem::get_unlocked_ids() const {
+    std::vector<uint32_t> ids(retired_unlocks);
+    for (const auto& achievement : achievements) {
+        if (achievement.unlocked) ids.push_back(achievement.id);
+    }
+    return ids;
 }
 
 int AchievementSystem::get_unlocked_count() const {
@@ -160,73 +183,67 @@ int AchievementSystem::get_unlocked_count() const {
 }
 
 // GameStats implementation
-GameStats::GameStats() {
-    load_stats();
+GameStats::GameStats() : journal(nullptr) {
+    clear();
 }
 
 void GameStats::update_game_end(int final_score, int final_level, int snake_length,
                                int foods_eaten, int special_foods, int max_combo_reached,
                                Uint32 game_duration) {
+    GameRecord record;
+    record.score = static_cast<uint32_t>(std::max(0, final_score));
+    record.level = static_cast<uint32_t>(std::max(0, final_level));
+    record.length = static_cast<uint32_t>(std::max(0, snake_length));
+    record.foods_eaten = static_cast<uint32_t>(std::max(0, foods_eaten));
+    record.special_foods = static_cast<uint32_t>(std::max(0, special_foods));
+    record.max_combo = static_cast<uint32_t>(std::max(0, max_combo_reached));
+    record.duration_ms = game_duration;
+    
+    apply_game(record);
+    if (journal) journal->append_game(record);
+}
+
+void GameStats::apply_game(const GameRecord& record) {
     games_played++;
-    total_score += final_score;
-    total_time_played += game_duration / 1000; // Convert to seconds
-    total_foods_eaten += foods_eaten;
-    special_foods_eaten += special_foods;
+    total_score += record.score;
+    total_time_played += record.duration_ms / 1000; // Convert to seconds
+    total_foods_eaten += record.foods_eaten;
+    special_foods_eaten += record.special_foods;
     
     // Update maximums
-    if (final_score > high_score) high_score = final_score;
-    if (final_level > max_level) max_level = final_level;
-    if (snake_length > max_length) max_length = snake_length;
-    if (max_combo_reached > max_combo) max_combo = max_combo_reached;
-    
-    save_stats();
+    if (static_cast<int>(record.score) > high_score) high_score = record.score;
+    if (static_cast<int>(record.level) > max_level) max_level = record.level;
+    if (static_cast<int>(record.length) > max_length) max_length = record.length;
+    if (static_cast<int>(record.max_combo) > max_combo) max_combo = record.max_combo;
 }
 
-void GameStats::save_stats() {
-    std::ofstream file("game_stats.dat");
-    if (!file.is_open()) return;
-    
-    file << games_played << std::endl
-         << high_score << std::endl
-         << max_level << std::endl
-         << max_length << std::endl
-         << total_score << std::endl
-         << total_time_played << std::endl
-         << total_foods_eaten << std::endl
-         << special_foods_eaten << std::endl
-         << max_combo << std::endl;
+void GameStats::clear() {
+    games_played = 0;
+    high_score = 0;
+    max_level = 0;
+    max_length = 0;
+    total_score = 0;
+    total_time_played = 0;
+    total_foods_eaten = 0;
+    special_foods_eaten = 0;
+    max_combo = 0;
 }
 
-void GameStats::load_stats() {
+bool GameStats::import_legacy_stats() {
     std::ifstream file("game_stats.dat");
-    if (!file.is_open()) {
-        // Initialize with defaults
-        games_played = 0;
-        high_score = 0;
-        max_level = 0;
-        max_length = 0;
-        total_score = 0;
-        total_time_played = 0;
-        total_foods_eaten = 0;
-        special_foods_eaten = 0;
-        max_combo = 0;
-        return;
-    }
+    if (!file.is_open()) return false;
     
     file >> games_played >> high_score >> max_level >> max_length
          >> total_score >> total_time_played >> total_foods_eaten
          >> special_foods_eaten >> max_combo;
+    if (!file) {
+        clear();
+        return false;
+    }
+    return true;
 }
 
 void GameStats::reset_stats() {
-    games_played = 0;
-    high_score = 0;
-    max_level = 0;
-    max_length = 0;
-    total_score = 0;
-    total_time_played = 0;
-    total_foods_eaten = 0;
-    special_foods_eaten = 0;
-    max_combo = 0;
-    save_stats();
-}
\ No newline at end of file
+    clear();
+    if (journal) journal->append_reset();
+}
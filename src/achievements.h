@@ -5,6 +5,8 @@
 #include <vector>
 #include <SDL2/SDL.h>
 
+#include "stats_journal.h"
+
 enum AchievementType {
     ACH_SCORE,
     ACH_LENGTH,
@@ -17,6 +19,8 @@ enum AchievementType {
 };
 
 struct Achievement {
+    std::string key;          // Never changes once shipped; saves refer to it
+    uint32_t id;              // StatsJournal::make_id(key)
     std::string name;
     std::string description;
     AchievementType type;
@@ -24,7 +28,7 @@ struct Achievement {
     bool unlocked;
     int progress;
     
-    Achievement(const std::string& name, const std::string& desc, 
+    Achievement(const std::string& key, const std::string& name, const std::string& desc,
                AchievementType type, int target);
     
     bool check_progress(const struct GameStats& stats);
@@ -41,26 +45,42 @@ struct GameStats {
     int total_foods_eaten;
     int special_foods_eaten;
     int max_combo;
+    StatsJournal* journal;    // Finished games are recorded here when set
     
     GameStats();
+    void set_journal(StatsJournal* stats_journal) { journal = stats_journal; }
     void update_game_end(int final_score, int final_level, int snake_length,
                         int foods_eaten, int special_foods, int max_combo_reached,
                         Uint32 game_duration);
-    void save_stats();
-    void load_stats();
+    void apply_game(const GameRecord& record);
+    void clear();
+    
+    // Clears the totals and journals it; unlocked achievements stay unlocked
     void reset_stats();
+    
+    // Totals from the old game_stats.dat; false if there is none
+    bool import_legacy_stats();
 };
 
 class AchievementSystem {
 private:
     std::vector<Achievement> achievements;
+    std::vector<uint32_t> retired_unlocks;  // Saved ids no longer in the list, kept
+    StatsJournal* journal;
     
     void init_achievements();
-    void save_progress();
-    void load_progress();
     
 public:
     AchievementSystem();
+    void set_journal(StatsJournal* stats_journal) { journal = stats_journal; }
+    
+    // Unlocks by id from the journal; progress is recomputed from stats
+    void restore(const GameStats& stats, const std::vector<uint32_t>& unlocked_ids);
+    
+    // Unlocks from the old achievements.dat, matched by name
+    void import_legacy_progress(const GameStats& stats);
+    
+    std::vector<uint32_t> get_unlocked_ids() const;
     
     std::vector<std::string> update(const GameStats& stats);
     const std::vector<Achievement>& get_achievements() const { return achievements; }
@@ -0,0 +1,114 @@
+#include "asset_archive.h"
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+AssetArchive::AssetArchive()
+    : mapping(nullptr), mapping_size(0), header(nullptr), table(nullptr), cached_fraction(0) {
+}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const std::string& path) {
+    close();
+    
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(PakHeader)) {
+        ::close(fd);
+        return false;
+    }
+    
+    // The mapping keeps the file referenced after the descriptor is closed
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+    
+    mapping = static_cast<const uint8_t*>(mapped);
+    mapping_size = info.st_size;
+    
+    // Before anything is read, or the header page would always count
+    size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> resident((mapping_size + page_size - 1) / page_size);
+    if (mincore(mapped, mapping_size, resident.data()) == 0) {
+        size_t cached = 0;
+        for (unsigned char page : resident) {
+            cached += page & 1;
+        }
+        cached_fraction = static_cast<float>(cached) / resident.size();
+    }
+    
+    header = reinterpret_cast<const PakHeader*>(mapping);
+    table = reinterpret_cast<const PakEntry*>(mapping + sizeof(PakHeader));
+    
+    bool valid = memcmp(header->magic, PAK_MAGIC, sizeof(PAK_MAGIC)) == 0 &&
+                 header->version == PAK_VERSION &&
+                 header->pixel_format == PAK_PIXEL_FORMAT &&
+                 header->table_size > 0 && (header->table_size & (header->table_size - 1)) == 0 &&
+                 sizeof(PakHeader) + static_cast<uint64_t>(header->table_size) * sizeof(PakEntry) <= mapping_size;
+    for (uint32_t i = 0; valid && i < header->table_size; i++) {
+        const PakEntry& entry = table[i];
+        if (entry.hash == 0) continue;
+        if (entry.offset > mapping_size || entry.size > mapping_size - entry.offset) {
+            valid = false;
+        }
+        
+        // Images are wrapped in surfaces as they are, so every row they
+        // describe must lie inside the entry
+        if (entry.kind == PAK_IMAGE &&
+            (entry.pitch < static_cast<uint64_t>(entry.width) * 4 ||
+             static_cast<uint64_t>(entry.height) * entry.pitch > entry.size)) {
+            valid = false;
+        }
+    }
+    if (!valid) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetArchive::close() {
+    if (mapping) {
+        munmap(const_cast<uint8_t*>(mapping), mapping_size);
+    }
+    mapping = nullptr;
+    mapping_size = 0;
+    header = nullptr;
+    table = nullptr;
+    cached_fraction = 0;
+}
+
+const PakEntry* AssetArchive::find(const std::string& path) const {
+    if (!mapping) return nullptr;
+    
+    uint64_t hash = hash_path(path);
+    uint32_t mask = header->table_size - 1;
+    for (uint32_t probe = 0; probe < header->table_size; probe++) {
+        const PakEntry& entry = table[(hash + probe) & mask];
+        if (entry.hash == 0) return nullptr;
+        if (entry.hash == hash) return &entry;
+    }
+    return nullptr;
+}
+
+const PakEntry* AssetArchive::find(const std::string& path, PakEntryKind kind) const {
+    const PakEntry* entry = find(path);
+    return (entry && entry->kind == static_cast<uint32_t>(kind)) ? entry : nullptr;
+}
+
+uint64_t AssetArchive::hash_path(const std::string& path) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : path) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash ? hash : 1;
+}
@@ -0,0 +1,82 @@
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// On-disk layout of data/assets.pak, written by tools/pack_assets.cpp.
+// All fields are little-endian and every blob starts on a 16-byte boundary.
+//
+//   PakHeader
+//   PakEntry[table_size]     open-addressing table keyed by path hash
+//   blobs
+const char PAK_MAGIC[8] = {'S', 'N', 'K', 'P', 'A', 'K', '1', '\0'};
+const uint32_t PAK_VERSION = 1;
+const size_t PAK_ALIGNMENT = 16;
+const uint32_t PAK_PIXEL_FORMAT = 0x16362004;  // SDL_PIXELFORMAT_ARGB8888, 4 bytes per pixel
+
+enum PakEntryKind {
+    PAK_EMPTY = 0,
+    PAK_IMAGE,          // PAK_PIXEL_FORMAT pixels, width x height, pitch bytes per row
+    PAK_SOUND,          // PCM in the header's audio format, ready for Mix_QuickLoad_RAW
+    PAK_RAW             // File bytes as-is (music streams, fonts)
+};
+
+struct PakHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t table_size;    // Power of two, at least twice the entry count
+    uint32_t entry_count;
+    uint32_t pixel_format;  // PAK_PIXEL_FORMAT
+    uint32_t audio_frequency;
+    uint16_t audio_format;  // SDL AUDIO_* of every sound
+    uint16_t audio_channels;
+};
+
+struct PakEntry {
+    uint64_t hash;          // hash_path() of the loose file path; 0 marks an empty slot
+    uint32_t kind;
+    uint32_t width;
+    uint32_t height;
+    uint32_t pitch;
+    uint64_t offset;        // From the start of the file
+    uint64_t size;
+};
+
+// Read-only, memory-mapped asset archive. Lookups hash the same relative
+// path the loose file would be opened with, so callers try the archive
+// first and fall back to the file system for anything it does not hold.
+// Returned pointers stay valid until close().
+class AssetArchive {
+private:
+    const uint8_t* mapping;
+    size_t mapping_size;
+    const PakHeader* header;
+    const PakEntry* table;
+    float cached_fraction;  // Of the file's pages, in the page cache when it was mapped
+    
+public:
+    AssetArchive();
+    ~AssetArchive();
+    
+    // False (and stays closed) if the file is missing, truncated, from
+    // another format version, or has an entry reaching outside the file
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return mapping != nullptr; }
+    
+    // Near 1 on a warm start, when an earlier run left the file in the page
+    // cache; near 0 on a cold one, when every page comes from the disk
+    float get_cached_fraction() const { return cached_fraction; }
+    
+    const PakEntry* find(const std::string& path) const;
+    const PakEntry* find(const std::string& path, PakEntryKind kind) const;
+    const void* get_data(const PakEntry* entry) const { return mapping + entry->offset; }
+    const PakHeader& get_header() const { return *header; }
+    
+    // FNV-1a, never 0
+    static uint64_t hash_path(const std::string& path);
+};
+
+#endif // ASSET_ARCHIVE_H
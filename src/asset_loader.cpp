@@ -0,0 +1,189 @@
+#include "asset_loader.h"
+#include "sprite_atlas.h"
+#include <SDL2/SDL_image.h>
+
+AssetLoader::AssetLoader()
+    : next_job(0), cancelled(false), delivered_count(0), required_count(0),
+      required_delivered(0), scan_start(0), start_counter(0), decode_end_counter(0),
+      decoded_count(0), archive(nullptr), archive_sounds(false) {
+}
+
+void AssetLoader::set_archive(const AssetArchive* asset_archive, bool use_sounds) {
+    archive = (asset_archive && asset_archive->is_open()) ? asset_archive : nullptr;
+    archive_sounds = archive && use_sounds;
+}
+
+AssetLoader::~AssetLoader() {
+    clear();
+}
+
+void AssetLoader::clear() {
+    stop();
+    for (size_t i = 0; i < jobs.size(); i++) {
+        if (!delivered[i]) release(jobs[i]);
+    }
+}
+
+size_t AssetLoader::add(AssetKind kind, const std::string& path, int id, bool required) {
+    AssetJob job = {kind, path, id, required, nullptr, nullptr, nullptr};
+    jobs.push_back(job);
+    delivered.push_back(false);
+    if (required) required_count++;
+    return jobs.size() - 1;
+}
+
+void AssetLoader::start(int thread_count) {
+    finished.reset(new std::atomic<bool>[jobs.size()]);
+    for (size_t i = 0; i < jobs.size(); i++) {
+        finished[i].store(false);
+    }
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < jobs.size(); i++) {
+            if (jobs[i].required == (pass == 0)) order.push_back(i);
+        }
+    }
+    start_counter = SDL_GetPerformanceCounter();
+    
+    for (int i = 0; i < thread_count; i++) {
+        SDL_Thread* worker = SDL_CreateThread(worker_main, "asset loader", this);
+        if (!worker) break;
+        workers.push_back(worker);
+    }
+}
+
+void AssetLoader::stop() {
+    cancelled.store(true);
+    for (auto worker : workers) {
+        SDL_WaitThread(worker, nullptr);
+    }
+    workers.clear();
+}
+
+int AssetLoader::worker_main(void* data) {
+    static_cast<AssetLoader*>(data)->run_jobs();
+    return 0;
+}
+
+void AssetLoader::run_jobs() {
+    while (!cancelled.load(std::memory_order_relaxed)) {
+        size_t claimed = next_job.fetch_add(1);
+        if (claimed >= order.size()) return;
+        
+        size_t index = order[claimed];
+        decode(jobs[index]);
+        if (decoded_count.fetch_add(1) + 1 == jobs.size()) {
+            decode_end_counter.store(SDL_GetPerformanceCounter());
+        }
+        finished[index].store(true, std::memory_order_release);
+    }
+}
+
+static_assert(PAK_PIXEL_FORMAT == SDL_PIXELFORMAT_ARGB8888, "archive images are ARGB8888");
+
+// Surface over the archive's pixels; freeing it leaves the mapping alone.
+// AssetArchive::open() has checked that the rows fit inside the entry.
+SDL_Surface* AssetLoader::wrap_image(const PakEntry* entry) const {
+    return SDL_CreateRGBSurfaceWithFormatFrom(const_cast<void*>(archive->get_data(entry)),
+                                              entry->width, entry->height, 32, entry->pitch,
+                                              PAK_PIXEL_FORMAT);
+}
+
+void AssetLoader::decode(AssetJob& job) const {
+    const PakEntry* entry = nullptr;
+    if (archive) {
+        switch (job.kind) {
+            case ASSET_SURFACE:
+            case ASSET_SPRITE_CELL: entry = archive->find(job.path, PAK_IMAGE); break;
+            case ASSET_CHUNK: entry = archive_sounds ? archive->find(job.path, PAK_SOUND) : nullptr; break;
+            case ASSET_MUSIC: entry = archive->find(job.path, PAK_RAW); break;
+        }
+    }
+    
+    if (entry) {
+        switch (job.kind) {
+            case ASSET_SURFACE:
+                job.surface = wrap_image(entry);
+                break;
+            case ASSET_SPRITE_CELL: {
+                SDL_Surface* image = wrap_image(entry);
+                job.surface = SpriteAtlas::make_cell(image);
+                if (image) SDL_FreeSurface(image);
+                break;
+            }
+            case ASSET_CHUNK:
+                // Plays straight from the mapping, nothing is copied
+                job.chunk = Mix_QuickLoad_RAW(static_cast<Uint8*>(const_cast<void*>(archive->get_data(entry))),
+                                              static_cast<Uint32>(entry->size));
+                break;
+            case ASSET_MUSIC:
+                job.music = Mix_LoadMUS_RW(SDL_RWFromConstMem(archive->get_data(entry), static_cast<int>(entry->size)), 1);
+                break;
+        }
+        if (job.surface || job.chunk || job.music) return;
+    }
+    
+    // Loose file: not packed, or the archive copy failed
+    switch (job.kind) {
+        case ASSET_SURFACE: {
+            SDL_Surface* loaded = IMG_Load(job.path.c_str());
+            if (loaded) {
+                // Upload-ready format, so the main thread only copies
+                job.surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+                SDL_FreeSurface(loaded);
+            }
+            break;
+        }
+        case ASSET_SPRITE_CELL:
+            job.surface = SpriteAtlas::load_cell(job.path);
+            break;
+        case ASSET_CHUNK:
+            job.chunk = Mix_LoadWAV(job.path.c_str());
+            break;
+        case ASSET_MUSIC:
+            job.music = Mix_LoadMUS(job.path.c_str());
+            break;
+    }
+}
+
+void AssetLoader::release(AssetJob& job) {
+    if (job.surface) SDL_FreeSurface(job.surface);
+    if (job.chunk) Mix_FreeChunk(job.chunk);
+    if (job.music) Mix_FreeMusic(job.music);
+    job.surface = nullptr;
+    job.chunk = nullptr;
+    job.music = nullptr;
+}
+
+AssetJob* AssetLoader::take_finished() {
+    if (!finished) return nullptr;
+    
+    // Without workers, decode one job here per call
+    if (workers.empty() && !cancelled.load()) {
+        size_t claimed = next_job.fetch_add(1);
+        if (claimed < order.size()) {
+            size_t index = order[claimed];
+            decode(jobs[index]);
+            if (decoded_count.fetch_add(1) + 1 == jobs.size()) {
+                decode_end_counter.store(SDL_GetPerformanceCounter());
+            }
+            finished[index].store(true, std::memory_order_release);
+        }
+    }
+    
+    while (scan_start < jobs.size() && delivered[scan_start]) scan_start++;
+    for (size_t i = scan_start; i < jobs.size(); i++) {
+        if (delivered[i] || !finished[i].load(std::memory_order_acquire)) continue;
+        
+        delivered[i] = true;
+        delivered_count++;
+        if (jobs[i].required) required_delivered++;
+        return &jobs[i];
+    }
+    return nullptr;
+}
+
+Uint32 AssetLoader::get_decode_time_ms() const {
+    Uint64 end = decode_end_counter.load();
+    if (end == 0) end = SDL_GetPerformanceCounter();
+    return static_cast<Uint32>((end - start_counter) * 1000 / SDL_GetPerformanceFrequency());
+}
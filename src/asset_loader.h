@@ -0,0 +1,98 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "asset_archive.h"
+
+// What a loader job produces
+enum AssetKind {
+    ASSET_SURFACE,      // Image decoded to an ARGB8888 surface, uploaded by the owner
+    ASSET_SPRITE_CELL,  // Image downsampled to a SpriteAtlas cell
+    ASSET_CHUNK,        // Sound effect in the opened device format
+    ASSET_MUSIC
+};
+
+struct AssetJob {
+    AssetKind kind;
+    std::string path;
+    int id;             // Caller's slot for the result (sound index, sprite character...)
+    bool required;      // The game cannot start without it having been tried
+    
+    SDL_Surface* surface;
+    Mix_Chunk* chunk;
+    Mix_Music* music;
+};
+
+// Decodes images and sounds on a pool of worker threads while the main thread
+// keeps rendering the loading screen. Jobs are claimed with an atomic counter,
+// required ones first, and handed back one by one through take_finished();
+// everything that needs the renderer (texture uploads) stays with the caller
+// on the main thread. A result that is never taken is freed by the loader.
+class AssetLoader {
+private:
+    std::vector<AssetJob> jobs;
+    std::vector<size_t> order;                      // Required jobs first, then the rest
+    std::unique_ptr<std::atomic<bool>[]> finished;  // Set by the worker that decoded the job
+    std::vector<bool> delivered;                    // Main thread only
+    std::vector<SDL_Thread*> workers;
+    std::atomic<size_t> next_job;
+    std::atomic<bool> cancelled;
+    
+    size_t delivered_count;
+    size_t required_count;
+    size_t required_delivered;
+    size_t scan_start;          // Jobs before this have all been delivered
+    Uint64 start_counter;
+    std::atomic<Uint64> decode_end_counter;  // Set by the worker that decodes the last job
+    std::atomic<size_t> decoded_count;
+    
+    const AssetArchive* archive;
+    bool archive_sounds;        // The archive's PCM matches the opened audio device
+    
+    static int worker_main(void* data);
+    void run_jobs();
+    void decode(AssetJob& job) const;
+    SDL_Surface* wrap_image(const PakEntry* entry) const;
+    static void release(AssetJob& job);
+    
+public:
+    AssetLoader();
+    ~AssetLoader();
+    
+    // Assets found in the archive are taken from its mapped memory instead of
+    // being decoded; sounds only when its PCM is in the device format. The
+    // archive must stay open for as long as any chunk or music it produced.
+    void set_archive(const AssetArchive* asset_archive, bool use_sounds);
+    
+    // Queue jobs before start(); returns the job index
+    size_t add(AssetKind kind, const std::string& path, int id, bool required);
+    
+    // Starts thread_count workers; with no threads the jobs are decoded on
+    // the caller's thread inside take_finished()
+    void start(int thread_count);
+    void stop();
+    
+    // Stops the workers and frees every result that was never taken
+    void clear();
+    
+    // Next decoded job not yet handed out, or nullptr. The caller takes
+    // ownership of its surface/chunk/music pointers.
+    AssetJob* take_finished();
+    
+    bool is_required_ready() const { return required_delivered == required_count; }
+    bool is_done() const { return delivered_count == jobs.size(); }
+    float get_progress() const { return jobs.empty() ? 1.0f : static_cast<float>(delivered_count) / jobs.size(); }
+    size_t get_job_count() const { return jobs.size(); }
+    int get_thread_count() const { return static_cast<int>(workers.size()); }
+    
+    // Wall time from start() until the last job was decoded (so far), in ms
+    Uint32 get_decode_time_ms() const;
+};
+
+#endif // ASSET_LOADER_H
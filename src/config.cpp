@@ -0,0 +1,78 @@
+#include "config.h"
+#include <fstream>
+#include <cstdlib>
+
+static std::string trim(const std::string& text) {
+    size_t start = text.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(start, end - start + 1);
+}
+
+bool Config::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    
+    std::string line;
+    std::string section;
+    
+    while (std::getline(file, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+        
+        if (line[0] == '[') {
+            size_t close = line.find(']');
+            if (close != std::string::npos) {
+                section = trim(line.substr(1, close - 1));
+            }
+            continue;
+        }
+        
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) continue;
+        
+        std::string key = trim(line.substr(0, equals));
+        values[section + "." + key] = trim(line.substr(equals + 1));
+    }
+    
+    return true;
+}
+
+const std::string* Config::find(const std::string& section, const std::string& key) const {
+    auto it = values.find(section + "." + key);
+    if (it == values.end()) return nullptr;
+    return &it->second;
+}
+
+std::string Config::get_string(const std::string& section, const std::string& key,
+                               const std::string& fallback) const {
+    const std::string* value = find(section, key);
+    return value ? *value : fallback;
+}
+
+int Config::get_int(const std::string& section, const std::string& key, int fallback) const {
+    const std::string* value = find(section, key);
+    if (!value || value->empty()) return fallback;
+    
+    char* end = nullptr;
+    long result = std::strtol(value->c_str(), &end, 10);
+    return (*end == '\0') ? static_cast<int>(result) : fallback;
+}
+
+float Config::get_float(const std::string& section, const std::string& key, float fallback) const {
+    const std::string* value = find(section, key);
+    if (!value || value->empty()) return fallback;
+    
+    char* end = nullptr;
+    float result = std::strtof(value->c_str(), &end);
+    return (*end == '\0') ? result : fallback;
+}
+
+bool Config::get_bool(const std::string& section, const std::string& key, bool fallback) const {
+    const std::string* value = find(section, key);
+    if (!value) return fallback;
+    
+    if (*value == "true" || *value == "1" || *value == "yes") return true;
+    if (*value == "false" || *value == "0" || *value == "no") return false;
+    return fallback;
+}
@@ -0,0 +1,25 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <string>
+#include <map>
+
+// Reader for config.ini: [SECTION] headers, KEY=value lines, '#' comments.
+// Missing files, keys or malformed values fall back to the caller's default.
+class Config {
+private:
+    std::map<std::string, std::string> values; // "SECTION.KEY" -> value
+    
+    const std::string* find(const std::string& section, const std::string& key) const;
+    
+public:
+    bool load(const std::string& path);
+    
+    std::string get_string(const std::string& section, const std::string& key,
+                           const std::string& fallback) const;
+    int get_int(const std::string& section, const std::string& key, int fallback) const;
+    float get_float(const std::string& section, const std::string& key, float fallback) const;
+    bool get_bool(const std::string& section, const std::string& key, bool fallback) const;
+};
+
+#endif // CONFIG_H
@@ -3,242 +3,43 @@
 #include <string>
 #include <fstream>
 #include <algorithm>
-
-// Snake implementation
-Snake::Snake() {
-    init();
-}
-
-void Snake::init() {
-    segments.clear();
-    direction = DIR_RIGHT;
-    next_direction = DIR_RIGHT;
-    
-    int start_x = GRID_WIDTH / 2;
-    int start_y = GRID_HEIGHT / 2;
-    
-    segments.push_back({start_x, start_y});
-    segments.push_back({start_x - 1, start_y});
-    segments.push_back({start_x - 2, start_y});
-}
-
-void Snake::move() {
-    direction = next_direction;
-    
-    // Move body segments
-    for (int i = segments.size() - 1; i > 0; i--) {
-        segments[i] = segments[i - 1];
-    }
-    
-    // Move head
-    switch (direction) {
-        case DIR_UP:
-            segments[0].y--;
-            break;
-        case DIR_DOWN:
-            segments[0].y++;
-            break;
-        case DIR_LEFT:
-            segments[0].x--;
-            break;
-        case DIR_RIGHT:
-            segments[0].x++;
-            break;
-    }
-}
-
-bool Snake::check_collision(bool phase_mode) {
-    const Segment& head = segments[0];
-    
-    // Check wall collision (unless in phase mode)
-    if (!phase_mode) {
-        if (head.x < 0 || head.x >= GRID_WIDTH || 
-            head.y < 0 || head.y >= GRID_HEIGHT) {
-            return true;
-        }
-    } else {
-        // In phase mode, wrap around walls
-        if (head.x < 0 || head.x >= GRID_WIDTH || 
-            head.y < 0 || head.y >= GRID_HEIGHT) {
-            segments[0].x = (head.x + GRID_WIDTH) % GRID_WIDTH;
-            segments[0].y = (head.y + GRID_HEIGHT) % GRID_HEIGHT;
-        }
-    }
-    
-    // Check self collision
-    for (size_t i = 1; i < segments.size(); i++) {
-        if (head.x == segments[i].x && head.y == segments[i].y) {
-            return true;
-        }
-    }
-    
-    return false;
-}
-
-void Snake::grow() {
-    if (segments.size() < GRID_WIDTH * GRID_HEIGHT) {
-        segments.push_back(segments.back());
-    }
-}
-
-void Snake::shrink(int amount) {
-    for (int i = 0; i < amount && segments.size() > 3; i++) {
-        segments.pop_back();
-    }
-}
-
-void Snake::change_direction(Direction new_dir) {
-    // Prevent the snake from reversing into itself
-    switch (new_dir) {
-        case DIR_UP:
-            if (direction != DIR_DOWN) {
-                next_direction = new_dir;
-            }
-            break;
-        case DIR_DOWN:
-            if (direction != DIR_UP) {
-                next_direction = new_dir;
-            }
-            break;
-        case DIR_LEFT:
-            if (direction != DIR_RIGHT) {
-                next_direction = new_dir;
-            }
-            break;
-        case DIR_RIGHT:
-            if (direction != DIR_LEFT) {
-                next_direction = new_dir;
-            }
-            break;
-    }
-}
-
-// Food implementation
-Food::Food() {
-    active = false;
-    type = FOOD_NORMAL;
-    spawn_time = 0;
-    pulse_phase = 0;
-    glow_intensity = 1.0f;
-}
-
-void Food::spawn(const Snake& snake) {
-    do {
-        x = rand() % GRID_WIDTH;
-        y = rand() % GRID_HEIGHT;
-    } while (std::any_of(snake.segments.begin(), snake.segments.end(),
-                        [this](const Segment& seg) { return seg.x == x && seg.y == y; }));
-    
-    active = true;
-    spawn_time = SDL_GetTicks() / 1000.0f;
-    pulse_phase = 0;
-    glow_intensity = 1.0f;
-}
-
-bool Food::check_collision(const Snake& snake) {
-    if (!active) return false;
-    return snake.segments[0].x == x && snake.segments[0].y == y;
-}
-
-FoodType Food::get_random_type(int level, int foods_eaten) {
-    int random = rand() % 100;
-    
-    // Base probabilities that change with level
-    if (random < 50) return FOOD_NORMAL;      // 50% normal food
-    if (random < 65) return FOOD_SPEED;       // 15% speed boost
-    if (random < 75) return FOOD_DOUBLE;      // 10% double score
-    if (random < 85) return FOOD_GOLDEN;      // 10% golden food
-    if (random < 92) return FOOD_SHRINK;      // 7% shrink food
-    if (random < 98) return FOOD_PHASE;       // 6% phase food
-    return FOOD_MEGA;                         // 2% mega food
-}
-
-SDL_Color Food::get_color() const {
-    switch (type) {
-        case FOOD_NORMAL: return {0, 255, 0, 255};      // Green
-        case FOOD_SPEED: return {255, 255, 0, 255};     // Yellow
-        case FOOD_DOUBLE: return {0, 255, 255, 255};    // Cyan
-        case FOOD_GOLDEN: return {255, 215, 0, 255};    // Gold
-        case FOOD_SHRINK: return {255, 0, 255, 255};    // Magenta
-        case FOOD_PHASE: return {128, 0, 255, 255};     // Purple
-        case FOOD_MEGA: return {255, 100, 100, 255};    // Red
-        default: return {255, 255, 255, 255};           // White
-    }
-}
-
-// PowerUps implementation
-PowerUps::PowerUps() {
-    init();
-}
-
-void PowerUps::init() {
-    speed_boost = false;
-    double_score = false;
-    phase_through_walls = false;
-    speed_end_time = 0;
-    double_score_end_time = 0;
-    phase_end_time = 0;
-    combo_multiplier = 1;
-    combo_count = 0;
-    last_food_time = 0;
-}
-
-void PowerUps::update(Uint32 current_time) {
-    if (speed_boost && current_time >= speed_end_time) {
-        speed_boost = false;
-    }
-    
-    if (double_score && current_time >= double_score_end_time) {
-        double_score = false;
-    }
-    
-    if (phase_through_walls && current_time >= phase_end_time) {
-        phase_through_walls = false;
-    }
-    
-    // Update combo system
-    if (current_time - last_food_time > 3000) { // 3 seconds timeout
-        combo_count = 0;
-        combo_multiplier = 1;
-    }
-}
-
-int PowerUps::get_score_multiplier() const {
-    int multiplier = combo_multiplier;
-    if (double_score) {
-        multiplier *= 2;
-    }
-    return multiplier;
-}
-
-// Particle implementation
-void Particle::update(float dt) {
-    x += vx * dt;
-    y += vy * dt;
-    life -= dt;
-    
-    // Fade out as life decreases
-    float life_ratio = life / max_life;
-    a = static_cast<Uint8>(255 * std::max(0.0f, life_ratio));
-}
+#include <sys/stat.h>
 
 // Game implementation
 Game::Game() : window(nullptr), renderer(nullptr), font(nullptr), large_font(nullptr),
+               font_atlas(nullptr), large_font_atlas(nullptr),
                background_music(nullptr), game_over_music(nullptr), eat_sound(nullptr),
                move_sound(nullptr), power_up_sound(nullptr), level_up_sound(nullptr),
-               bg_texture(nullptr), loading_texture(nullptr),
-               state(STATE_MENU), difficulty(DIFFICULTY_NORMAL), score(0), high_score(0),
-               running(true), level(1), foods_needed_for_level(5), base_score_per_food(10),
-               foods_eaten(0), special_foods_eaten(0), game_start_time(0),
-               last_move_time(0), move_delay(200), base_move_delay(200),
+               bg_texture(nullptr), loading_texture(nullptr), char_sprites(nullptr),
+               sim_thread(SIM_TICK_MS, MAX_FRAME_CATCH_UP_MS), snapshot(nullptr),
+               handled_event_seq(0), particle_burst_scale(1),
+               state(STATE_MENU), difficulty(DIFFICULTY_NORMAL), high_score(0),
+               running(true), game_start_time(0), base_move_delay(200),
+               fps_target(60), vsync_enabled(false), show_debug_info(false),
+               smooth_movement(true),
                food_pulse(0), game_over_alpha(0), screen_shake_intensity(0),
                screen_shake_end_time(0), loading_progress(0), loading_start_time(0),
+               run_rank(0), run_rank_total(0), run_week_rank(0),
                game_stats(nullptr), achievement_system(nullptr) {
-    srand(static_cast<unsigned int>(time(nullptr)));
+    snapshot = &sim_thread.get_snapshot();
+    effects_rng.seed(make_game_seed(), EFFECTS_RNG_STREAM);
     
     // Initialize achievement system
     game_stats = new GameStats();
     achievement_system = new AchievementSystem();
+    stats_journal.set_save_writer(&save_writer);
+    
+    std::vector<uint32_t> unlocked_ids;
+    if (stats_journal.load(*game_stats, unlocked_ids)) {
+        achievement_system->restore(*game_stats, unlocked_ids);
+    } else {
+        // First run with the journal: carry over the old text saves once
+        game_stats->import_legacy_stats();
+        achievement_system->import_legacy_progress(*game_stats);
+        stats_journal.checkpoint(*game_stats, achievement_system->get_unlocked_ids(), true);
+    }
+    game_stats->set_journal(&stats_journal);
+    achievement_system->set_journal(&stats_journal);
 }
 
 Game::~Game() {
@@ -248,6 +49,21 @@ Game::~Game() {
 }
 
 bool Game::init() {
+    // Settings are optional; the game runs on defaults without config.ini
+    if (!config.load("config.ini") && !config.load("../config.ini")) {
+        std::cerr << "Warning: config.ini not found - using defaults" << std::endl;
+    }
+    fps_target = std::max(0, config.get_int("ADVANCED", "FPS_TARGET", 60));
+    vsync_enabled = config.get_bool("ADVANCED", "VSYNC", false);
+    show_debug_info = config.get_bool("ADVANCED", "SHOW_DEBUG_INFO", false);
+    smooth_movement = config.get_bool("GRAPHICS", "SMOOTH_MOVEMENT", true);
+    
+    int max_particles = config.get_int("GRAPHICS", "PARTICLE_COUNT", MAX_PARTICLES);
+    max_particles = std::max(0, std::min(max_particles, PARTICLE_COUNT_LIMIT));
+    particles.set_capacity(max_particles);
+    particle_burst_scale = std::max(1, max_particles / MAX_PARTICLES);
+    loading_particles.set_capacity(LOADING_PARTICLES);
+    
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         std::cerr << "Erreur SDL: " << SDL_GetError() << std::endl;
         return false;
@@ -263,7 +79,11 @@ bool Game::init() {
         return false;
     }
     
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    Uint32 renderer_flags = SDL_RENDERER_ACCELERATED;
+    if (vsync_enabled) {
+        renderer_flags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    renderer = SDL_CreateRenderer(window, -1, renderer_flags);
     
     if (!renderer) {
         std::cerr << "Erreur création renderer: " << SDL_GetError() << std::endl;
@@ -276,8 +96,11 @@ bool Game::init() {
         return false;
     }
     
+    // Packed assets first, so the fonts can come from it too
+    open_asset_archive();
+    
     // Load fonts
-    font = TTF_OpenFont("data/polices/arial.ttf", 16);
+    font = open_font("data/polices/arial.ttf", 16);
     if (!font) {
         // Try system font
         font = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", 16);
@@ -287,7 +110,7 @@ bool Game::init() {
         }
     }
     
-    large_font = TTF_OpenFont("data/polices/arial.ttf", 24);
+    large_font = open_font("data/polices/arial.ttf", 24);
     if (!large_font) {
         large_font = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf", 24);
         if (!large_font) {
@@ -295,6 +118,42 @@ bool Game::init() {
         }
     }
     
+    batch.set_renderer(renderer);
+    snake_mesh.reserve_quads(snapshot->get_snake().get_capacity() * SNAKE_QUADS_PER_SEGMENT);
+    segment_positions.reserve(snapshot->get_snake().get_capacity());
+    
+    // Backgrounds are one stretched column instead of a rect per scanline
+    if (!background_strip.create(renderer, SCREEN_HEIGHT)) {
+        std::cerr << "Warning: Could not create background texture: " << SDL_GetError() << std::endl;
+    }
+    
+    // Cached layers for the grid, the sidebar and the menu text
+    SDL_Rect playfield_area = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+    SDL_Rect sidebar_area = {SCREEN_WIDTH, 0, 200, SCREEN_HEIGHT};
+    SDL_Rect window_area = {0, 0, SCREEN_WIDTH + 200, SCREEN_HEIGHT};
+    if (!grid_layer.create(renderer, playfield_area) ||
+        !hud_layer.create(renderer, sidebar_area) ||
+        !menu_layer.create(renderer, window_area)) {
+        std::cerr << "Warning: Render targets unavailable - layers are redrawn every frame" << std::endl;
+    }
+    
+    // Glow sprites for orbs, food and the snake head, built up front
+    glow_cache.set_renderer(renderer);
+    glow_cache.get(DATA_NODE_GLOW_RADIUS, {100, 150, 200, 255});
+    glow_cache.get(MENU_ORB_GLOW_RADIUS, {130, 170, 255, 255});
+    glow_cache.get(HEAD_GLOW_RADIUS, {40, 200, 80, 255});
+    for (int type = 0; type < FOOD_TYPE_COUNT; type++) {
+        glow_cache.get(FOOD_GLOW_RADIUS, get_food_color(static_cast<FoodType>(type)));
+    }
+    
+    // Glyph caches so text drawing never creates textures in the frame loop
+    font_atlas = new GlyphAtlas(renderer, font);
+    font_atlas->warm_up();
+    if (large_font != font) {
+        large_font_atlas = new GlyphAtlas(renderer, large_font);
+        large_font_atlas->warm_up();
+    }
+    
     // Initialize audio
     if (!load_audio()) {
         std::cerr << "Warning: Could not load audio" << std::endl;
@@ -305,8 +164,22 @@ bool Game::init() {
         std::cerr << "Warning: Could not load all textures" << std::endl;
     }
     
-    // Initialize particles
-    particles.reserve(MAX_PARTICLES);
+    // Decode everything queued above while the loading screen runs. The image
+    // codecs are loaded here first, as SDL_image would otherwise do it lazily
+    // from several loader threads at once.
+    IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+    asset_loader.start(std::max(1, std::min(ASSET_LOADER_MAX_THREADS, SDL_GetCPUCount() - 1)));
+    
+    // Saves from here on never block a frame
+    save_writer.start();
+    score_store.set_save_writer(&save_writer);
+    score_store.open(SCORE_STORE_PATH);
+    
+    // Every game is recorded; an hour of play takes about 140 KB
+    if (config.get_bool("ADVANCED", "RECORD_REPLAYS", true)) {
+        mkdir(REPLAY_DIR, 0755);
+        sim_thread.set_replay_output(&save_writer, REPLAY_DIR);
+    }
     
     // Load high score
     load_high_score();
@@ -320,83 +193,174 @@ bool Game::load_audio() {
         return false; // Continue without audio
     }
     
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+    // The mixer renders one buffer ahead, so a sound waits up to a buffer
+    // before it is heard; SDL rounds the size to a power of two
+    int buffer_frames = AUDIO_BUFFER_FRAMES;
+    if (config.get_bool("AUDIO", "LOW_LATENCY_AUDIO", true)) {
+        buffer_frames = std::max(64, std::min(AUDIO_BUFFER_FRAMES,
+                                              config.get_int("AUDIO", "AUDIO_BUFFER_FRAMES", LOW_LATENCY_BUFFER_FRAMES)));
+    }
+    if (Mix_OpenAudio(AUDIO_FREQUENCY, MIX_DEFAULT_FORMAT, 2, buffer_frames) < 0) {
         std::cerr << "Warning: Could not open audio device: " << Mix_GetError() << std::endl;
         return false; // Continue without audio
     }
     
-    // Load background music
-    background_music = Mix_LoadMUS("data/sons/music.mp3");
-    if (!background_music) {
-        std::cerr << "Warning: Could not load background music - continuing without music" << std::endl;
+    voices.open(std::max(1, config.get_int("AUDIO", "SFX_VOICES", SFX_VOICES)));
+    voices.set_volumes(config.get_int("AUDIO", "MASTER_VOLUME", MIX_MAX_VOLUME),
+                       config.get_int("AUDIO", "SFX_VOLUME", MIX_MAX_VOLUME),
+                       config.get_int("AUDIO", "MUSIC_VOLUME", MIX_MAX_VOLUME));
+    
+    // Packed PCM is only usable as-is when the device opened in its format
+    if (asset_archive.is_open()) {
+        int frequency = 0, channels = 0;
+        Uint16 format = 0;
+        const PakHeader& header = asset_archive.get_header();
+        bool matches = Mix_QuerySpec(&frequency, &format, &channels) != 0 &&
+                       static_cast<Uint32>(frequency) == header.audio_frequency &&
+                       format == header.audio_format && channels == header.audio_channels;
+        if (!matches) {
+            std::cerr << "Warning: Packed sounds do not match the audio device, loading the .wav files" << std::endl;
+        }
+        asset_loader.set_archive(&asset_archive, matches);
     }
     
-    game_over_music = Mix_LoadMUS("data/sons/choc.mp3");
-    if (!game_over_music) {
-        std::cerr << "Warning: Could not load game over music - continuing without music" << std::endl;
-    }
+    // Music is queued on the loader; the menu starts it, so wait for it
+    asset_loader.add(ASSET_MUSIC, "data/sons/music.mp3", ASSET_ID_MUSIC, true);
+    asset_loader.add(ASSET_MUSIC, "data/sons/choc.mp3", ASSET_ID_GAME_OVER_MUSIC, false);
     
-    // Load sound effects from the existing directory structure
+    // Sound effects from the existing directory structure. Only files that
+    // exist are queued, so missing ones cost a stat rather than a failed open.
     sound_effects.resize(30, nullptr);
     for (int i = 0; i < 30; i++) {
-        std::string path = "data/sons/Sound Effects/sound_" + std::to_string(i) + ".wav";
-        sound_effects[i] = Mix_LoadWAV(path.c_str());
-        if (!sound_effects[i]) {
-            // Try alternative path
-            path = "data/sons/Sound/sound_" + std::to_string(i) + ".wav";
-            sound_effects[i] = Mix_LoadWAV(path.c_str());
-            // If still fails, just continue - sound effects are optional
+        const std::string candidates[] = {
+            "data/sons/Sound Effects/sound_" + std::to_string(i) + ".wav",
+            "data/sons/Sound/sound_" + std::to_string(i) + ".wav"
+        };
+        for (const std::string& path : candidates) {
+            if (has_asset(path, PAK_SOUND)) {
+                // Sound effects are optional and may arrive after the menu shows
+                asset_loader.add(ASSET_CHUNK, path, i, false);
+                break;
+            }
         }
     }
     
     return true;
 }
 
-bool Game::load_textures() {
-    // Load background - use fallback if not available
-    bg_texture = load_texture("data/images/bg.jpg");
-    
-    // Load loading screen - use fallback if not available
-    loading_texture = load_texture("data/images/chargement.jpg");
-    
-    // Score and letter textures are optional - the game will render text instead
-    score_textures.resize(10, nullptr);
-    letter_textures.resize(26, nullptr);
+void Game::open_asset_archive() {
+    if (!config.get_bool("ADVANCED", "USE_ASSET_ARCHIVE", true)) return;
+    if (access(ASSET_ARCHIVE_PATH, R_OK) != 0) return;  // Not built: loose files only
     
-    return true; // Always return true since textures are optional
+    if (asset_archive.open(ASSET_ARCHIVE_PATH)) {
+        asset_loader.set_archive(&asset_archive, false);
+        std::cout << "📦 Asset archive: " << asset_archive.get_header().entry_count
+                  << " entries mapped from " << ASSET_ARCHIVE_PATH << std::endl;
+    } else {
+        std::cerr << "Warning: Ignoring " << ASSET_ARCHIVE_PATH
+                  << " (unreadable or from another version), loading the loose files" << std::endl;
+    }
 }
 
-SDL_Texture* Game::load_texture(const std::string& path) {
-    SDL_Surface* surface = IMG_Load(path.c_str());
-    if (!surface) {
-        // Silently continue without texture - fallbacks will be used
-        return nullptr;
+// Packed or loose; lets optional assets be skipped without a failed open
+bool Game::has_asset(const std::string& path, PakEntryKind kind) const {
+    if (asset_archive.is_open() && asset_archive.find(path, kind)) return true;
+    return access(path.c_str(), R_OK) == 0;
+}
+
+TTF_Font* Game::open_font(const std::string& path, int size) {
+    const PakEntry* entry = asset_archive.is_open() ? asset_archive.find(path, PAK_RAW) : nullptr;
+    if (entry) {
+        SDL_RWops* rw = SDL_RWFromConstMem(asset_archive.get_data(entry), static_cast<int>(entry->size));
+        TTF_Font* packed = TTF_OpenFontRW(rw, 1, size);
+        if (packed) return packed;
     }
+    return TTF_OpenFont(path.c_str(), size);
+}
+
+void Game::play_sound(int sound_id, SoundPriority priority) {
+    if (sound_id < 0 || sound_id >= static_cast<int>(sound_effects.size())) return;
+    voices.play(sound_effects[sound_id], priority);
+}
+
+bool Game::load_textures() {
+    // Backgrounds are optional - fallbacks will be used
+    asset_loader.add(ASSET_SURFACE, "data/images/bg.jpg", ASSET_ID_BACKGROUND, false);
+    asset_loader.add(ASSET_SURFACE, "data/images/chargement.jpg", ASSET_ID_LOADING_SCREEN, false);
     
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    
-    if (!texture) {
-        std::cerr << "Warning: Could not create texture from " << path << ": " << SDL_GetError() << std::endl;
+    // Snake digits and letters, packed into one atlas once all are decoded;
+    // the HUD falls back to the font for any that are missing
+    char_sprites = new SpriteAtlas(renderer);
+    for (int i = 0; i < 10; i++) {
+        asset_loader.add(ASSET_SPRITE_CELL, "data/texture/score/" + std::to_string(i) + ".png", '0' + i, true);
+    }
+    for (int i = 0; i < 26; i++) {
+        asset_loader.add(ASSET_SPRITE_CELL, "data/texture/nom/lettre_" + std::to_string(i + 1) + ".png", 'A' + i, true);
     }
     
-    return texture;
+    return true; // Always return true since textures are optional
+}
+
+// Takes whatever the loader threads have decoded; textures are created here
+// because the renderer belongs to the main thread
+void Game::receive_assets() {
+    AssetJob* job;
+    while ((job = asset_loader.take_finished()) != nullptr) {
+        switch (job->kind) {
+            case ASSET_SURFACE: {
+                SDL_Texture* texture = nullptr;
+                if (job->surface) {
+                    texture = SDL_CreateTextureFromSurface(renderer, job->surface);
+                    SDL_FreeSurface(job->surface);
+                    if (!texture) {
+                        std::cerr << "Warning: Could not create texture from " << job->path << ": " << SDL_GetError() << std::endl;
+                    }
+                }
+                if (job->id == ASSET_ID_BACKGROUND) bg_texture = texture;
+                else if (job->id == ASSET_ID_LOADING_SCREEN) loading_texture = texture;
+                else if (texture) SDL_DestroyTexture(texture);
+                break;
+            }
+            case ASSET_SPRITE_CELL:
+                char_sprites->add_cell(static_cast<char>(job->id), job->surface);
+                break;
+            case ASSET_CHUNK:
+                sound_effects[job->id] = job->chunk;
+                break;
+            case ASSET_MUSIC:
+                if (job->id == ASSET_ID_MUSIC) background_music = job->music;
+                else game_over_music = job->music;
+                if (!job->music) {
+                    std::cerr << "Warning: Could not load " << job->path << " - continuing without music" << std::endl;
+                }
+                break;
+        }
+        job->surface = nullptr;
+        job->chunk = nullptr;
+        job->music = nullptr;
+    }
 }
 
 void Game::cleanup() {
+    sim_thread.stop();
+    save_writer.stop();  // Writes whatever is still queued
+    score_store.close();
+    asset_loader.clear();
+    
     // Clean up textures
     if (bg_texture) SDL_DestroyTexture(bg_texture);
     if (loading_texture) SDL_DestroyTexture(loading_texture);
     
-    for (auto texture : score_textures) {
-        if (texture) SDL_DestroyTexture(texture);
-    }
-    
-    for (auto texture : letter_textures) {
-        if (texture) SDL_DestroyTexture(texture);
-    }
+    delete char_sprites;
+    char_sprites = nullptr;
+    background_strip.destroy();
+    glow_cache.clear();
+    grid_layer.destroy();
+    hud_layer.destroy();
+    menu_layer.destroy();
     
     // Clean up audio
+    voices.close();
     if (background_music) Mix_FreeMusic(background_music);
     if (game_over_music) Mix_FreeMusic(game_over_music);
     if (eat_sound) Mix_FreeChunk(eat_sound);
@@ -408,7 +372,11 @@ void Game::cleanup() {
         if (sound) Mix_FreeChunk(sound);
     }
     
-    // Clean up fonts
+    // Clean up fonts (glyph atlases hold renderer textures, so go first)
+    delete font_atlas;
+    delete large_font_atlas;
+    font_atlas = nullptr;
+    large_font_atlas = nullptr;
     if (font) TTF_CloseFont(font);
     if (large_font) TTF_CloseFont(large_font);
     
@@ -416,7 +384,11 @@ void Game::cleanup() {
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window) SDL_DestroyWindow(window);
     
+    // Chunks, music and fonts above could point into the mapping
+    asset_archive.close();
+    
     TTF_Quit();
+    IMG_Quit();
     Mix_CloseAudio();
     Mix_Quit();
     SDL_Quit();
@@ -427,9 +399,9 @@ void Game::run() {
     loading_start_time = SDL_GetTicks();
     loading_particles.clear();
     
-    // Show loading screen with animation for 3 seconds
-    Uint32 loading_duration = 3000;
-    while (SDL_GetTicks() - loading_start_time < loading_duration) {
+    // Show the loading screen until every required asset is in; optional
+    // sounds keep arriving during the menu
+    while (true) {
         // Handle quit events during loading
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
@@ -439,19 +411,75 @@ void Game::run() {
             }
         }
         
+        receive_assets();
+        if (asset_loader.is_required_ready()) break;
+        
         render_loading_screen();
         SDL_Delay(16); // ~60 FPS
     }
+    char_sprites->pack();
+    
+    // SDL_GetTicks() starts at SDL_Init, right at launch. Cold and warm
+    // starts are told apart by how much of the archive was already cached.
+    std::cout << "⏱ Time to menu, ";
+    if (asset_archive.is_open()) {
+        int cached_percent = static_cast<int>(asset_archive.get_cached_fraction() * 100 + 0.5f);
+        std::cout << (cached_percent >= 50 ? "warm" : "cold") << " start (" << cached_percent
+                  << "% of " << ASSET_ARCHIVE_PATH << " cached): ";
+    } else {
+        std::cout << "loose files: ";
+    }
+    std::cout << SDL_GetTicks() << " ms (" << asset_loader.get_job_count()
+              << " assets on " << asset_loader.get_thread_count() << " threads, decoded in "
+              << asset_loader.get_decode_time_ms() << " ms so far)" << std::endl;
     
     if (background_music) {
         Mix_PlayMusic(background_music, -1);
     }
     
+    // Simulation ticks run at an exact rate on the simulation thread; this
+    // loop pumps events and renders the newest snapshot once per frame, as
+    // fast as FPS_TARGET (0 = uncapped) or vsync allows
+    if (!sim_thread.start()) {
+        std::cerr << "Erreur thread de simulation: " << SDL_GetError() << std::endl;
+        return;
+    }
+    
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 max_frame_time = frequency * MAX_FRAME_CATCH_UP_MS / 1000;
+    const Uint64 frame_duration = fps_target > 0 ? frequency / fps_target : 0;
+    
+    Uint64 previous_time = SDL_GetPerformanceCounter();
+    
     while (running) {
+        Uint64 frame_start = SDL_GetPerformanceCounter();
+        Uint64 elapsed = std::min(frame_start - previous_time, max_frame_time);
+        previous_time = frame_start;
+        
         handle_events();
+        if (!asset_loader.is_done()) receive_assets();
         update();
+        
+        update_effects(static_cast<float>(elapsed) / frequency);
         render();
-        SDL_Delay(16); // ~60 FPS
+        
+        if (frame_duration > 0) {
+            wait_for_frame(frame_start + frame_duration);
+        }
+    }
+}
+
+void Game::wait_for_frame(Uint64 deadline) {
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 now = SDL_GetPerformanceCounter();
+    
+    // Sleep through most of the wait, then spin the last millisecond for precision
+    while (now < deadline) {
+        Uint64 remaining_ms = (deadline - now) * 1000 / frequency;
+        if (remaining_ms > 1) {
+            SDL_Delay(static_cast<Uint32>(remaining_ms - 1));
+        }
+        now = SDL_GetPerformanceCounter();
     }
 }
 
@@ -462,6 +490,13 @@ void Game::handle_events() {
             running = false;
         }
         
+        // Render target contents are lost with the device
+        if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+            grid_layer.mark_dirty();
+            hud_layer.mark_dirty();
+            menu_layer.mark_dirty();
+        }
+        
         if (event.type == SDL_KEYDOWN) {
             switch (state) {
                 case STATE_MENU:
@@ -469,14 +504,17 @@ void Game::handle_events() {
                         case SDLK_1:
                             difficulty = DIFFICULTY_EASY;
                             base_move_delay = 250;
+                            menu_layer.mark_dirty();
                             break;
                         case SDLK_2:
                             difficulty = DIFFICULTY_NORMAL;
                             base_move_delay = 200;
+                            menu_layer.mark_dirty();
                             break;
                         case SDLK_3:
                             difficulty = DIFFICULTY_HARD;
                             base_move_delay = 150;
+                            menu_layer.mark_dirty();
                             break;
                         case SDLK_SPACE:
                         case SDLK_RETURN:
@@ -490,27 +528,28 @@ void Game::handle_events() {
                     switch (event.key.keysym.sym) {
                         case SDLK_UP:
                         case SDLK_w:
-                            snake.change_direction(DIR_UP);
-                            if (sound_effects[4]) Mix_PlayChannel(1, sound_effects[4], 0);
+                            sim_thread.push_turn(DIR_UP, event.key.timestamp);
+                            play_sound(4, SOUND_PRIORITY_LOW);
                             break;
                         case SDLK_DOWN:
                         case SDLK_s:
-                            snake.change_direction(DIR_DOWN);
-                            if (sound_effects[4]) Mix_PlayChannel(1, sound_effects[4], 0);
+                            sim_thread.push_turn(DIR_DOWN, event.key.timestamp);
+                            play_sound(4, SOUND_PRIORITY_LOW);
                             break;
                         case SDLK_LEFT:
                         case SDLK_a:
-                            snake.change_direction(DIR_LEFT);
-                            if (sound_effects[4]) Mix_PlayChannel(1, sound_effects[4], 0);
+                            sim_thread.push_turn(DIR_LEFT, event.key.timestamp);
+                            play_sound(4, SOUND_PRIORITY_LOW);
                             break;
                         case SDLK_RIGHT:
                         case SDLK_d:
-                            snake.change_direction(DIR_RIGHT);
-                            if (sound_effects[4]) Mix_PlayChannel(1, sound_effects[4], 0);
+                            sim_thread.push_turn(DIR_RIGHT, event.key.timestamp);
+                            play_sound(4, SOUND_PRIORITY_LOW);
                             break;
                         case SDLK_p:
                         case SDLK_ESCAPE:
                             state = STATE_PAUSED;
+                            sim_thread.set_running(false);
                             break;
                     }
                     break;
@@ -518,12 +557,14 @@ void Game::handle_events() {
                 case STATE_PAUSED:
                     if (event.key.keysym.sym == SDLK_p || event.key.keysym.sym == SDLK_ESCAPE) {
                         state = STATE_PLAYING;
+                        sim_thread.set_running(true);
                     }
                     break;
                     
                 case STATE_GAME_OVER:
                     if (event.key.keysym.sym == SDLK_SPACE || event.key.keysym.sym == SDLK_RETURN) {
                         state = STATE_MENU;
+                        menu_layer.mark_dirty(); // Record and achievements may have changed
                     }
                     break;
             }
@@ -532,41 +573,70 @@ void Game::handle_events() {
 }
 
 void Game::update() {
+    sim_thread.acquire();
+    snapshot = &sim_thread.get_snapshot();
+    if (state != STATE_PLAYING || snapshot->generation != sim_thread.get_generation()) return;
+    
+    // React to each event once; the simulation keeps resending them until acknowledged
+    for (size_t i = 0; i < snapshot->events.size() && state == STATE_PLAYING; i++) {
+        uint32_t seq = snapshot->first_event_seq + static_cast<uint32_t>(i);
+        if (static_cast<int32_t>(seq - handled_event_seq) < 0) continue;
+        
+        handle_sim_event(snapshot->events[i]);
+        handled_event_seq = seq + 1;
+    }
+    sim_thread.acknowledge_events(handled_event_seq);
+}
+
+void Game::update_effects(float dt) {
     if (state != STATE_PLAYING) return;
     
     Uint32 current_time = SDL_GetTicks();
     
-    // Update power-ups
-    power_ups.update(current_time);
-    
-    // Update food animation
-    food.pulse_phase += 0.1f;
-    if (food.pulse_phase > 2 * M_PI) {
-        food.pulse_phase = 0;
+    // Update food animation (0.1 rad per 60 Hz frame)
+    food_pulse += 6.0f * dt;
+    if (food_pulse > 2 * M_PI) {
+        food_pulse = 0;
     }
-    food.glow_intensity = 0.8f + 0.2f * sinf(food.pulse_phase);
     
     // Update particles
-    update_particles();
+    update_particles(dt);
     
-    // Update screen shake
+    // Update screen shake, decaying at the same rate whatever the frame rate
     if (current_time < screen_shake_end_time) {
         float shake_progress = (float)(screen_shake_end_time - current_time) / 500.0f;
-        screen_shake_intensity *= shake_progress;
+        screen_shake_intensity *= powf(std::min(shake_progress, 1.0f), dt * 60.0f);
     } else {
         screen_shake_intensity = 0.0f;
     }
-    
-    // Determine current move delay based on power-ups and level
-    Uint32 current_move_delay = get_level_speed(level, power_ups.is_speed_active());
-    
-    // Move snake based on timing
-    if (current_time - last_move_time >= current_move_delay) {
-        snake.move();
-        last_move_time = current_time;
+}
+
+void Game::handle_sim_event(const SimEvent& event) {
+    switch (event.type) {
+        case SIM_EVENT_FOOD_EATEN: {
+            // Spawn particles at food location
+            float x = event.x * GRID_SIZE + GRID_SIZE/2;
+            float y = event.y * GRID_SIZE + GRID_SIZE/2;
+            spawn_food_particles(x, y, event.food_type);
+            spawn_power_up_particles(x, y, event.food_type);
+            
+            if (event.food_type == FOOD_MEGA) {
+                add_screen_shake(10.0f, 500);
+            }
+            
+            // Play eat sound
+            play_sound(3, SOUND_PRIORITY_NORMAL);
+            break;
+        }
         
-        // Check wall collision (with phase mode support)
-        if (snake.check_collision(power_ups.is_phase_active())) {
+        case SIM_EVENT_LEVEL_UP:
+            add_screen_shake(5.0f, 300);
+            
+            play_sound(10, SOUND_PRIORITY_NORMAL);
+            break;
+            
+        case SIM_EVENT_GAME_OVER: {
+            int score = snapshot->get_score();
             game_over_alpha = 0;
             if (score > high_score) {
                 high_score = score;
@@ -575,140 +645,32 @@ void Game::update() {
             
             // Update game statistics and check achievements
             Uint32 game_duration = SDL_GetTicks() - game_start_time;
-            game_stats->update_game_end(score, level, snake.get_length(),
-                                     foods_eaten, special_foods_eaten,
-                                     power_ups.combo_multiplier, game_duration);
+            game_stats->update_game_end(score, snapshot->get_level(), snapshot->get_snake().get_length(),
+                                     snapshot->get_foods_eaten(), snapshot->get_special_foods_eaten(),
+                                     snapshot->get_power_ups().combo_multiplier, game_duration);
+            
+            ScoreRecord run = {};
+            run.timestamp = static_cast<uint64_t>(time(nullptr));
+            run.score = static_cast<uint32_t>(std::max(0, score));
+            run.duration_ms = game_duration;
+            run.length = static_cast<uint32_t>(snapshot->get_snake().get_length());
+            run.level = static_cast<uint16_t>(snapshot->get_level());
+            run.difficulty = static_cast<uint8_t>(difficulty);
+            run.max_combo = static_cast<uint32_t>(snapshot->get_power_ups().combo_multiplier);
+            run.foods_eaten = static_cast<uint32_t>(snapshot->get_foods_eaten());
+            score_store.add(run);
+            run_rank = score_store.get_rank(difficulty, run.score);
+            run_rank_total = score_store.get_run_count(difficulty);
+            run_week_rank = score_store.get_rank(difficulty, run.score, SCORE_WINDOW_WEEK, run.timestamp);
             
             auto new_achievements = achievement_system->update(*game_stats);
             // TODO: Display achievement notifications
             
-            if (sound_effects[21]) {
-                Mix_PlayChannel(-1, sound_effects[21], 0);
-            }
+            play_sound(21, SOUND_PRIORITY_HIGH);
             state = STATE_GAME_OVER;
-            return;
-        }
-        
-        // Check collision with food
-        if (food.check_collision(snake)) {
-            // Spawn particles at food location
-            spawn_food_particles(food.x * GRID_SIZE + GRID_SIZE/2, 
-                                food.y * GRID_SIZE + GRID_SIZE/2, food.type);
-            spawn_power_up_particles(food.x * GRID_SIZE + GRID_SIZE/2,
-                                   food.y * GRID_SIZE + GRID_SIZE/2, food.type);
-            
-            // Apply food effect
-            apply_food_effect(food.type);
-            
-            // Spawn new food
-            food.spawn(snake);
-            food.type = food.get_random_type(level, foods_eaten);
-            
-            foods_eaten++;
-            
-            // Check if level up
-            if (foods_eaten >= foods_needed_for_level) {
-                level_up();
-            }
-            
-            // Play eat sound
-            if (sound_effects[3]) {
-                Mix_PlayChannel(1, sound_effects[3], 0);
-            }
-        }
-    }
-}
-
-void Game::apply_food_effect(FoodType type) {
-    Uint32 current_time = SDL_GetTicks();
-    
-    // Update combo system
-    power_ups.combo_count++;
-    power_ups.combo_multiplier = 1 + (power_ups.combo_count / 3); // Increase every 3 foods
-    power_ups.last_food_time = current_time;
-    
-    int base_points = base_score_per_food;
-    int multiplier = power_ups.get_score_multiplier();
-    
-    switch (type) {
-        case FOOD_NORMAL:
-            snake.grow();
-            score += base_points * multiplier;
-            break;
-            
-        case FOOD_SPEED:
-            snake.grow();
-            score += (base_points + 5) * multiplier;
-            power_ups.speed_boost = true;
-            power_ups.speed_end_time = current_time + 5000; // 5 seconds
-            special_foods_eaten++;
-            break;
-            
-        case FOOD_DOUBLE:
-            snake.grow();
-            score += base_points * multiplier;
-            power_ups.double_score = true;
-            power_ups.double_score_end_time = current_time + 8000; // 8 seconds
-            special_foods_eaten++;
-            break;
-            
-        case FOOD_GOLDEN:
-            snake.grow();
-            score += (base_points * 3) * multiplier;
-            special_foods_eaten++;
-            break;
-            
-        case FOOD_SHRINK:
-            snake.shrink(2);
-            score += (base_points / 2) * multiplier;
-            special_foods_eaten++;
             break;
-            
-        case FOOD_PHASE:
-            snake.grow();
-            score += (base_points + 10) * multiplier;
-            power_ups.phase_through_walls = true;
-            power_ups.phase_end_time = current_time + 6000; // 6 seconds
-            special_foods_eaten++;
-            break;
-            
-        case FOOD_MEGA:
-            snake.grow();
-            score += (base_points * 5) * multiplier;
-            add_screen_shake(10.0f, 500);
-            special_foods_eaten++;
-            break;
-    }
-}
-
-void Game::level_up() {
-    level++;
-    foods_needed_for_level = get_level_required_foods(level);
-    foods_eaten = 0;
-    
-    // Increase base score per food
-    base_score_per_food += 2;
-    
-    add_screen_shake(5.0f, 300);
-    
-    if (sound_effects[10]) {
-        Mix_PlayChannel(-1, sound_effects[10], 0);
-    }
-}
-
-Uint32 Game::get_level_speed(int level, bool speed_boost) {
-    Uint32 speed = base_move_delay - (level - 1) * 10;
-    speed = std::max(speed, 50u); // Minimum delay
-    
-    if (speed_boost) {
-        speed = speed * 0.6f; // 40% faster
+        }
     }
-    
-    return speed;
-}
-
-int Game::get_level_required_foods(int level) {
-    return 5 + (level - 1) * 2; // 5, 7, 9, 11, ...
 }
 
 void Game::add_screen_shake(float intensity, Uint32 duration) {
@@ -717,21 +679,13 @@ void Game::add_screen_shake(float intensity, Uint32 duration) {
 }
 
 void Game::reset() {
-    snake.init();
-    food.spawn(snake);
-    food.type = food.get_random_type(1, 0);
-    power_ups.init();
-    
-    score = 0;
-    level = 1;
-    foods_needed_for_level = 5;
-    foods_eaten = 0;
-    special_foods_eaten = 0;
-    base_score_per_food = 10;
+    if (!sim_thread.reset(base_move_delay, make_game_seed()) || !sim_thread.wait_for_reset(1000)) {
+        std::cerr << "Warning: simulation thread did not start the new game" << std::endl;
+    }
+    snapshot = &sim_thread.get_snapshot();
+    handled_event_seq = snapshot->first_event_seq;
     game_start_time = SDL_GetTicks();
     
-    move_delay = base_move_delay;
-    last_move_time = 0;
     food_pulse = 0;
     game_over_alpha = 0;
     screen_shake_intensity = 0.0f;
@@ -742,6 +696,7 @@ void Game::reset() {
 
 // Rendering methods
 void Game::render() {
+    frame_stats.reset();
     SDL_SetRenderDrawColor(renderer, 20, 20, 35, 255);
     SDL_RenderClear(renderer);
     
@@ -761,13 +716,14 @@ void Game::render() {
             break;
     }
     
-    SDL_RenderPresent(renderer);
+    present_frame();
 }
 
 void Game::render_loading_screen() {
     // Calculate animation progress (0.0 to 1.0 over 3 seconds)
     float elapsed = (SDL_GetTicks() - loading_start_time) / 3000.0f;
     elapsed = std::min(elapsed, 1.0f);
+    frame_stats.reset();
     
     // Dynamic gradient background
     render_futuristic_background(elapsed);
@@ -782,26 +738,39 @@ void Game::render_loading_screen() {
     // Subtitle with typewriter effect
     render_animated_subtitle(elapsed);
     
-    // Progress bar
-    render_loading_progress(elapsed);
+    // Progress bar, from the assets actually loaded
+    loading_progress = asset_loader.get_progress();
+    render_loading_progress(loading_progress);
+    
+    present_frame();
+}
+
+void Game::present_frame() {
+    batch.flush();
+    
+    frame_stats.submitted_draws = batch.get_submitted_draws();
+    frame_stats.draw_calls = batch.get_draw_calls();
+    batch.reset_stats();
+    last_frame_stats = frame_stats;
     
     SDL_RenderPresent(renderer);
 }
 
 void Game::render_futuristic_background(float progress) {
     // Dynamic gradient from dark blue to purple to pink
+    // Color transitions based on progress (the same for every line)
+    double red_shift = 50 * sin(progress * 6.28f);
+    double blue_shift = 80 * sin(progress * 3.14f);
     for (int y = 0; y < SCREEN_HEIGHT; y++) {
         float gradient = (float)y / SCREEN_HEIGHT;
         
-        // Color transitions based on progress
-        Uint8 r = static_cast<Uint8>(10 + (100 * progress) + (50 * sin(progress * 6.28f)) + gradient * 30);
+        Uint8 r = static_cast<Uint8>(10 + (100 * progress) + red_shift + gradient * 30);
         Uint8 g = static_cast<Uint8>(5 + (50 * progress) + gradient * 50);
-        Uint8 b = static_cast<Uint8>(30 + (120 * progress) + (80 * sin(progress * 3.14f)) + gradient * 100);
+        Uint8 b = static_cast<Uint8>(30 + (120 * progress) + blue_shift + gradient * 100);
         
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-        SDL_Rect line = {0, y, SCREEN_WIDTH + 200, 1};
-        SDL_RenderFillRect(renderer, &line);
+        background_strip.set_row(y, r, g, b);
     }
+    frame_stats.background_draw_calls += background_strip.draw(batch, SCREEN_WIDTH + 200);
     
     // Add moving stars/sparkles
     int star_count = static_cast<int>(30 * progress);
@@ -813,9 +782,9 @@ void Game::render_futuristic_background(float progress) {
         float alpha = sin(star_time * 3) * 0.5f + 0.5f;
         Uint8 star_alpha = static_cast<Uint8>(255 * alpha * progress);
         
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, star_alpha);
+        batch.set_draw_color(255, 255, 255, star_alpha);
         SDL_Rect star = {x-1, y-1, 3, 3};
-        SDL_RenderFillRect(renderer, &star);
+        batch.fill_rect(&star);
     }
 }
 
@@ -892,10 +861,7 @@ void Game::render_animated_subtitle(float progress) {
 }
 
 void Game::render_loading_progress(float progress) {
-    if (progress < 0.3f) return;
-    
-    float bar_progress = (progress - 0.3f) / 0.7f;
-    bar_progress = std::min(bar_progress, 1.0f);
+    float bar_progress = std::max(0.0f, std::min(progress, 1.0f));
     
     int bar_width = 300;
     int bar_height = 8;
@@ -903,9 +869,9 @@ void Game::render_loading_progress(float progress) {
     int bar_y = SCREEN_HEIGHT/2 + 80;
     
     // Background bar
-    SDL_SetRenderDrawColor(renderer, 40, 40, 60, 200);
+    batch.set_draw_color(40, 40, 60, 200);
     SDL_Rect bg_bar = {bar_x - 2, bar_y - 2, bar_width + 4, bar_height + 4};
-    SDL_RenderFillRect(renderer, &bg_bar);
+    batch.fill_rect(&bg_bar);
     
     // Progress bar with gradient
     int fill_width = static_cast<int>(bar_width * bar_progress);
@@ -915,55 +881,50 @@ void Game::render_loading_progress(float progress) {
         Uint8 g = static_cast<Uint8>(200 - 100 * gradient);
         Uint8 b = static_cast<Uint8>(255 - 155 * gradient);
         
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+        batch.set_draw_color(r, g, b, 255);
         SDL_Rect fill = {bar_x + i, bar_y, 1, bar_height};
-        SDL_RenderFillRect(renderer, &fill);
+        batch.fill_rect(&fill);
     }
     
     // Loading text
     std::string loading_text = "Loading Revolutionary Experience... " + 
                               std::to_string(static_cast<int>(bar_progress * 100)) + "%";
-    SDL_Color text_color = {200, 200, 255, static_cast<Uint8>(255 * bar_progress)};
+    SDL_Color text_color = {200, 200, 255, 255};
     render_text(loading_text, SCREEN_WIDTH/2 - 150, SCREEN_HEIGHT/2 + 100, text_color);
 }
 
 void Game::update_loading_particles(float progress) {
     // Add new particles based on progress
     if (loading_particles.size() < static_cast<size_t>(50 * progress)) {
-        Particle p;
-        p.x = static_cast<float>(rand() % (SCREEN_WIDTH + 200));
-        p.y = static_cast<float>(SCREEN_HEIGHT + 10);
-        p.vx = (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 2;
-        p.vy = -static_cast<float>(rand() % 3 + 1);
-        p.life = p.max_life = 3.0f + static_cast<float>(rand() % 3);
-        p.r = 100 + rand() % 156;
-        p.g = 150 + rand() % 106;
-        p.b = 200 + rand() % 56;
-        p.a = 255;
-        loading_particles.push_back(p);
+        float x = static_cast<float>(effects_rng.next_below(SCREEN_WIDTH + 200));
+        float y = static_cast<float>(SCREEN_HEIGHT + 10);
+        float vx = (effects_rng.next_float() - 0.5f) * 2;
+        float vy = -static_cast<float>(effects_rng.next_below(3) + 1);
+        float life = 3.0f + static_cast<float>(effects_rng.next_below(3));
+        SDL_Color color = {
+            static_cast<Uint8>(100 + effects_rng.next_below(156)),
+            static_cast<Uint8>(150 + effects_rng.next_below(106)),
+            static_cast<Uint8>(200 + effects_rng.next_below(56)),
+            255
+        };
+        loading_particles.add(x, y, vx, vy, life, color);
     }
     
     // Update existing particles
-    for (auto it = loading_particles.begin(); it != loading_particles.end();) {
-        it->update(0.016f); // Assuming ~60fps
-        if (!it->is_alive()) {
-            it = loading_particles.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    loading_particles.update(0.016f); // Assuming ~60fps
 }
 
 void Game::render_loading_particles() {
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    for (const auto& p : loading_particles) {
-        SDL_SetRenderDrawColor(renderer, p.r, p.g, p.b, p.a);
+    batch.set_blend_mode(SDL_BLENDMODE_BLEND);
+    for (size_t i = 0; i < loading_particles.size(); i++) {
+        SDL_Color color = loading_particles.get_color(i);
+        batch.set_draw_color(color.r, color.g, color.b, color.a);
         SDL_Rect particle_rect = {
-            static_cast<int>(p.x) - 1, 
-            static_cast<int>(p.y) - 1, 
+            static_cast<int>(loading_particles.get_x(i)) - 1, 
+            static_cast<int>(loading_particles.get_y(i)) - 1, 
             3, 3
         };
-        SDL_RenderFillRect(renderer, &particle_rect);
+        batch.fill_rect(&particle_rect);
     }
 }
 
@@ -973,6 +934,13 @@ void Game::render_menu() {
     // Spectacular animated title
     render_holographic_title();
     
+    // Static menu text, redrawn only when the selection or records change
+    if (menu_layer.begin(batch)) {
+        render_menu_static_layer();
+        menu_layer.end(batch);
+    }
+    menu_layer.composite(batch);
+    
     // Interactive difficulty selection with modern UI
     render_modern_difficulty_selection();
     
@@ -981,27 +949,30 @@ void Game::render_menu() {
     
     // Professional stats and info panel
     render_info_panel();
+    render_leaderboard_panel();
     
     // Futuristic controls hint
     render_futuristic_controls();
 }
 
 void Game::render_game() {
-    render_gradient_background();
-    
-    // Apply screen shake
+    // Screen shake moves the playfield, applied as an offset at composite time
     int shake_x = 0, shake_y = 0;
     if (screen_shake_intensity > 0) {
-        shake_x = static_cast<int>((rand() % 21 - 10) * screen_shake_intensity / 10.0f);
-        shake_y = static_cast<int>((rand() % 21 - 10) * screen_shake_intensity / 10.0f);
+        shake_x = static_cast<int>((static_cast<int>(effects_rng.next_below(21)) - 10) * screen_shake_intensity / 10.0f);
+        shake_y = static_cast<int>((static_cast<int>(effects_rng.next_below(21)) - 10) * screen_shake_intensity / 10.0f);
     }
     
+    render_gradient_background(shake_x, shake_y);
+    
     // Render game elements
+    batch.set_origin(shake_x, shake_y);
     render_food();
     render_snake();
     render_particles();
+    batch.set_origin(0, 0);
+    
     render_ui();
-    render_power_up_indicators();
 }
 
 void Game::render_game_over() {
@@ -1020,7 +991,7 @@ void Game::render_game_over() {
     render_achievement_showcase(time);
     
     // High score celebration
-    if (score == high_score && score > 0) {
+    if (snapshot->get_score() == high_score && snapshot->get_score() > 0) {
         render_high_score_celebration(time);
     }
     
@@ -1031,87 +1002,102 @@ void Game::render_game_over() {
 void Game::render_snake() {
     float time = SDL_GetTicks() / 1000.0f;
     
-    for (size_t i = 0; i < snake.segments.size(); i++) {
-        const Segment& seg = snake.segments[i];
-        SDL_Rect rect = {seg.x * GRID_SIZE, seg.y * GRID_SIZE, GRID_SIZE, GRID_SIZE};
+    const SnakeSnapshot& snake = snapshot->get_snake();
+    if (snake.get_length() == 0) return;
+    
+    // Segments slide from their cell before the last move to their current one
+    update_segment_positions(smooth_movement ? get_move_progress() : 1.0f);
+    
+    // Head - completely redesigned
+    SDL_Rect head_rect = {segment_positions[0].x, segment_positions[0].y, GRID_SIZE, GRID_SIZE};
+    render_futuristic_snake_head(head_rect, time);
+    
+    // The body, scales and joints go into one mesh and one draw call
+    snake_mesh.clear();
+    for (size_t i = 1; i < static_cast<size_t>(snake.get_length()); i++) {
+        SDL_Rect rect = {segment_positions[i].x, segment_positions[i].y, GRID_SIZE, GRID_SIZE};
         
-        if (i == 0) { // Head - completely redesigned
-            render_futuristic_snake_head(rect, time);
-        } else {
-            render_futuristic_snake_body(rect, i, time);
-        }
+        render_futuristic_snake_body(rect, i, time);
         
         // Add connection joints between segments for smoother appearance
-        if (i > 0) {
-            render_snake_joint(i);
-        }
+        render_snake_joint(i);
     }
+    batch.draw_mesh(snake_mesh);
 }
 
 void Game::render_food() {
-    if (!food.active) return;
+    if (!snapshot->get_food().active) return;
     
     float time = SDL_GetTicks() / 1000.0f;
-    SDL_Rect base_rect = {food.x * GRID_SIZE, food.y * GRID_SIZE, GRID_SIZE, GRID_SIZE};
+    SDL_Rect base_rect = {snapshot->get_food().x * GRID_SIZE, snapshot->get_food().y * GRID_SIZE, GRID_SIZE, GRID_SIZE};
     
     // Enhanced power-core styling based on food type
-    render_power_core_food(base_rect, food.type, time);
+    render_power_core_food(base_rect, snapshot->get_food().type, time);
 }
 
 void Game::render_ui() {
     float time = SDL_GetTicks() / 1000.0f;
     int ui_x = SCREEN_WIDTH + 20;
     
-    // Professional HUD header
-    render_text("═══ MISSION DATA ═══", ui_x, 10, {100, 200, 255, 255});
+    // Static sidebar text and bars, redrawn only when the values behind them change
+    HudLayerState hud_state = get_hud_layer_state();
+    if (!(hud_state == hud_layer_state)) {
+        hud_layer_state = hud_state;
+        hud_layer.mark_dirty();
+    }
+    if (hud_layer.begin(batch)) {
+        render_hud_static_layer(ui_x);
+        hud_layer.end(batch);
+    }
+    hud_layer.composite(batch);
     
     // Score with dynamic effects
     float score_pulse = sin(time * 3) * 0.2f + 0.8f;
-    std::string score_text = "◈ SCORE: " + std::to_string(score);
     SDL_Color score_color = {
         static_cast<Uint8>(255 * score_pulse),
         static_cast<Uint8>(215 * score_pulse),
         0, 255
     };
-    render_text(score_text, ui_x, 40, score_color);
+    int label_width = render_label("◈ SCORE: ", ui_x, 40, score_color);
+    render_number(snapshot->get_score(), ui_x + label_width, 40, score_color);
     
     // Level with progress visualization
     render_level_display(ui_x, 70, time);
     
-    // Snake status
-    std::string length_text = "◇ LENGTH: " + std::to_string(snake.get_length());
-    render_text(length_text, ui_x, 140, {100, 255, 100, 255});
-    
     // Combo system display
     render_combo_display(ui_x, 170, time);
     
     // Mission timer
     render_mission_timer(ui_x, SCREEN_HEIGHT - 60, time);
+    
+    if (show_debug_info) {
+        render_debug_info(ui_x, 220);
+    }
 }
 
 void Game::render_power_up_indicators() {
     int y_offset = SCREEN_HEIGHT - 120;
     
     // Speed boost indicator
-    if (power_ups.is_speed_active()) {
+    if (snapshot->get_power_ups().is_speed_active()) {
         render_text("SPEED BOOST", SCREEN_WIDTH + 20, y_offset, {255, 255, 0, 255});
         y_offset += 25;
     }
     
     // Double score indicator
-    if (power_ups.is_double_score_active()) {
+    if (snapshot->get_power_ups().is_double_score_active()) {
         render_text("DOUBLE SCORE", SCREEN_WIDTH + 20, y_offset, {0, 255, 255, 255});
         y_offset += 25;
     }
     
     // Phase indicator
-    if (power_ups.is_phase_active()) {
+    if (snapshot->get_power_ups().is_phase_active()) {
         render_text("PHASE MODE", SCREEN_WIDTH + 20, y_offset, {255, 0, 255, 255});
         y_offset += 25;
     }
 }
 
-void Game::render_gradient_background() {
+void Game::render_gradient_background(int shake_x, int shake_y) {
     // Advanced dynamic background for gameplay
     float time = SDL_GetTicks() / 1000.0f;
     
@@ -1125,19 +1111,22 @@ void Game::render_gradient_background() {
         Uint8 g = static_cast<Uint8>(std::max(0, std::min(255, static_cast<int>(20 + gradient * 35 + wave2 * 15))));
         Uint8 b = static_cast<Uint8>(std::max(0, std::min(255, static_cast<int>(35 + gradient * 60 + wave1 * 25))));
         
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-        SDL_Rect line = {0, y, SCREEN_WIDTH, 1};
-        SDL_RenderFillRect(renderer, &line);
+        background_strip.set_row(y, r, g, b);
     }
+    frame_stats.background_draw_calls += background_strip.draw(batch, SCREEN_WIDTH);
     
-    // Digital grid overlay
-    SDL_SetRenderDrawColor(renderer, 30, 50, 80, 60);
-    for (int x = 0; x < SCREEN_WIDTH; x += 40) {
-        SDL_RenderDrawLine(renderer, x, 0, x, SCREEN_HEIGHT);
-    }
-    for (int y = 0; y < SCREEN_HEIGHT; y += 40) {
-        SDL_RenderDrawLine(renderer, 0, y, SCREEN_WIDTH, y);
+    // Digital grid overlay, drawn once and shaken with the playfield
+    if (grid_layer.begin(batch)) {
+        batch.set_draw_color(30, 50, 80, 60);
+        for (int x = 0; x < SCREEN_WIDTH; x += 40) {
+            batch.draw_line(x, 0, x, SCREEN_HEIGHT);
+        }
+        for (int y = 0; y < SCREEN_HEIGHT; y += 40) {
+            batch.draw_line(0, y, SCREEN_WIDTH, y);
+        }
+        grid_layer.end(batch);
     }
+    grid_layer.composite(batch, shake_x, shake_y);
     
     // Floating data nodes
     for (int i = 0; i < 15; i++) {
@@ -1148,17 +1137,7 @@ void Game::render_gradient_background() {
         float glow = (sin(node_time * 2) + 1) / 2;
         Uint8 alpha = static_cast<Uint8>(40 + glow * 60);
         
-        SDL_SetRenderDrawColor(renderer, 100, 150, 200, alpha);
-        for (int radius = 0; radius < 3; radius++) {
-            for (int dx = -radius; dx <= radius; dx++) {
-                for (int dy = -radius; dy <= radius; dy++) {
-                    if (dx*dx + dy*dy <= radius*radius) {
-                        SDL_Rect pixel = {x + dx, y + dy, 1, 1};
-                        SDL_RenderFillRect(renderer, &pixel);
-                    }
-                }
-            }
-        }
+        glow_cache.draw(batch, x, y, DATA_NODE_GLOW_RADIUS, {100, 150, 200, 255}, alpha);
     }
     
     // Animated starfield with depth
@@ -1172,58 +1151,71 @@ void Game::render_gradient_background() {
             Uint8 alpha = static_cast<Uint8>((80 + layer * 30) * twinkle);
             Uint8 size = 1 + layer;
             
-            SDL_SetRenderDrawColor(renderer, 255 - layer * 50, 255 - layer * 30, 255, alpha);
+            batch.set_draw_color(255 - layer * 50, 255 - layer * 30, 255, alpha);
             SDL_Rect star = {star_x, star_y, size, size};
-            SDL_RenderFillRect(renderer, &star);
+            batch.fill_rect(&star);
         }
     }
 }
 
 void Game::render_text(const std::string& text, int x, int y, SDL_Color color, TTF_Font* font_to_use) {
-    if (!font_to_use) font_to_use = font;
-    if (!font_to_use) return;
-    
-    SDL_Surface* surface = TTF_RenderText_Solid(font_to_use, text.c_str(), color);
-    if (!surface) return;
+    GlyphAtlas* atlas = get_glyph_atlas(font_to_use);
+    if (!atlas) return;
     
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
+    atlas->draw(batch, text, x, y, color);
+}
+
+// Font text that reports its width, for labels followed by sprite digits
+int Game::render_label(const std::string& text, int x, int y, SDL_Color color) {
+    GlyphAtlas* atlas = get_glyph_atlas(nullptr);
+    if (!atlas) return 0;
     
-    if (!texture) return;
+    return atlas->draw(batch, text, x, y, color);
+}
+
+// Draws a counter with the snake digit sprites, zero-padded to min_digits.
+// The sprites keep their own colours; only the brightness of color pulses them.
+int Game::render_number(int value, int x, int y, SDL_Color color, int min_digits) {
+    std::string digits = std::to_string(value);
+    if (static_cast<int>(digits.size()) < min_digits) {
+        digits.insert(0, min_digits - digits.size(), '0');
+    }
     
-    int w, h;
-    SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
-    SDL_Rect dest = {x, y, w, h};
+    bool have_sprites = char_sprites && char_sprites->is_loaded();
+    for (char c : digits) {
+        if (have_sprites && !char_sprites->has(c)) have_sprites = false;
+    }
+    if (!have_sprites) {
+        return render_label(digits, x, y, color);
+    }
     
-    SDL_RenderCopy(renderer, texture, nullptr, &dest);
-    SDL_DestroyTexture(texture);
+    Uint8 brightness = std::max(color.r, std::max(color.g, color.b));
+    SDL_Color tint = {brightness, brightness, brightness, color.a};
+    return char_sprites->draw(batch, digits, x, y - 1, HUD_DIGIT_HEIGHT, tint);
+}
+
+GlyphAtlas* Game::get_glyph_atlas(TTF_Font* font_to_use) {
+    if (font_to_use && large_font_atlas && font_to_use == large_font) {
+        return large_font_atlas;
+    }
+    return font_atlas;
 }
 
 // Particle system
 void Game::add_particle(float x, float y, float vx, float vy, SDL_Color color) {
-    if (particles.size() >= MAX_PARTICLES) return;
+    if (particles.full()) return;
     
-    Particle p;
-    p.x = x;
-    p.y = y;
-    p.vx = vx;
-    p.vy = vy;
-    p.life = 1.0f + (rand() % 100) / 100.0f; // 1-2 seconds
-    p.max_life = p.life;
-    p.r = color.r;
-    p.g = color.g;
-    p.b = color.b;
-    p.a = color.a;
-    
-    particles.push_back(p);
+    float life = 1.0f + effects_rng.next_below(100) / 100.0f; // 1-2 seconds
+    particles.add(x, y, vx, vy, life, color);
 }
 
 void Game::spawn_food_particles(float x, float y, FoodType type) {
-    SDL_Color color = food.get_color();
+    SDL_Color color = get_food_color(type);
     
-    for (int i = 0; i < 10; i++) {
-        float angle = static_cast<float>(i) * 2 * M_PI / 10;
-        float speed = 50 + rand() % 50;
+    int burst = 10 * particle_burst_scale;
+    for (int i = 0; i < burst; i++) {
+        float angle = static_cast<float>(i) * 2 * M_PI / burst;
+        float speed = 50 + effects_rng.next_below(50);
         float vx = cosf(angle) * speed;
         float vy = sinf(angle) * speed;
         
@@ -1236,9 +1228,10 @@ void Game::spawn_power_up_particles(float x, float y, FoodType type) {
     
     SDL_Color color = {255, 255, 0, 255}; // Gold particles for special foods
     
-    for (int i = 0; i < 15; i++) {
-        float angle = static_cast<float>(rand()) / RAND_MAX * 2 * M_PI;
-        float speed = 30 + rand() % 70;
+    int burst = 15 * particle_burst_scale;
+    for (int i = 0; i < burst; i++) {
+        float angle = effects_rng.next_float() * 2 * M_PI;
+        float speed = 30 + effects_rng.next_below(70);
         float vx = cosf(angle) * speed;
         float vy = sinf(angle) * speed;
         
@@ -1246,37 +1239,45 @@ void Game::spawn_power_up_particles(float x, float y, FoodType type) {
     }
 }
 
-void Game::update_particles() {
-    float dt = 0.016f; // ~60fps
-    
-    for (auto it = particles.begin(); it != particles.end();) {
-        it->update(dt);
-        if (!it->is_alive()) {
-            it = particles.erase(it);
-        } else {
-            ++it;
-        }
-    }
+void Game::update_particles(float dt) {
+    particles.update(dt);
 }
 
 void Game::render_particles() {
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    batch.set_blend_mode(SDL_BLENDMODE_BLEND);
     
-    for (const auto& particle : particles) {
-        SDL_SetRenderDrawColor(renderer, particle.r, particle.g, particle.b, particle.a);
-        SDL_RenderDrawPoint(renderer, static_cast<int>(particle.x), static_cast<int>(particle.y));
-        SDL_RenderDrawPoint(renderer, static_cast<int>(particle.x) + 1, static_cast<int>(particle.y));
-        SDL_RenderDrawPoint(renderer, static_cast<int>(particle.x), static_cast<int>(particle.y) + 1);
+    for (size_t i = 0; i < particles.size(); i++) {
+        SDL_Color color = particles.get_color(i);
+        int x = static_cast<int>(particles.get_x(i));
+        int y = static_cast<int>(particles.get_y(i));
+        batch.set_draw_color(color.r, color.g, color.b, color.a);
+        batch.draw_point(x, y);
+        batch.draw_point(x + 1, y);
+        batch.draw_point(x, y + 1);
+    }
+}
+
+SDL_Color Game::get_food_color(FoodType type) const {
+    switch (type) {
+        case FOOD_NORMAL: return {0, 255, 0, 255};      // Green
+        case FOOD_SPEED: return {255, 255, 0, 255};     // Yellow
+        case FOOD_DOUBLE: return {0, 255, 255, 255};    // Cyan
+        case FOOD_GOLDEN: return {255, 215, 0, 255};    // Gold
+        case FOOD_SHRINK: return {255, 0, 255, 255};    // Magenta
+        case FOOD_PHASE: return {128, 0, 255, 255};     // Purple
+        case FOOD_MEGA: return {255, 100, 100, 255};    // Red
+        default: return {255, 255, 255, 255};           // White
     }
 }
 
+uint64_t Game::make_game_seed() {
+    // Wall clock plus the high-resolution counter, so back-to-back games differ
+    return (static_cast<uint64_t>(time(nullptr)) << 32) ^ SDL_GetPerformanceCounter();
+}
+
 // Save/Load system
 void Game::save_high_score() {
-    std::ofstream file("highscore.dat");
-    if (file.is_open()) {
-        file << high_score;
-        file.close();
-    }
+    save_writer.write("highscore.dat", std::to_string(high_score));
 }
 
 void Game::load_high_score() {
@@ -1300,20 +1301,19 @@ void Game::render_futuristic_menu_background() {
         Uint8 g = static_cast<Uint8>(10 + (40 * gradient) + (20 * sin(time * 0.7f + gradient * 3.14f)));
         Uint8 b = static_cast<Uint8>(40 + (100 * gradient) + (30 * wave));
         
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-        SDL_Rect line = {0, y, SCREEN_WIDTH + 200, 1};
-        SDL_RenderFillRect(renderer, &line);
+        background_strip.set_row(y, r, g, b);
     }
+    frame_stats.background_draw_calls += background_strip.draw(batch, SCREEN_WIDTH + 200);
     
     // Animated grid pattern
-    SDL_SetRenderDrawColor(renderer, 30, 50, 80, 100);
+    batch.set_draw_color(30, 50, 80, 100);
     for (int x = 0; x < SCREEN_WIDTH + 200; x += 40) {
         for (int y = 0; y < SCREEN_HEIGHT; y += 40) {
             float alpha_mod = sin(time + x * 0.01f + y * 0.01f) * 0.5f + 0.5f;
             if (alpha_mod > 0.7f) {
                 SDL_Rect dot = {x + static_cast<int>(sin(time + x) * 2), 
                                y + static_cast<int>(cos(time + y) * 2), 2, 2};
-                SDL_RenderFillRect(renderer, &dot);
+                batch.fill_rect(&dot);
             }
         }
     }
@@ -1328,21 +1328,7 @@ void Game::render_futuristic_menu_background() {
         Uint8 alpha = static_cast<Uint8>(80 * glow);
         
         // Render orb with glow effect
-        for (int radius = 8; radius > 0; radius -= 2) {
-            SDL_SetRenderDrawColor(renderer, 
-                                 100 + radius * 15, 
-                                 150 + radius * 10, 
-                                 255, 
-                                 alpha / (radius / 2 + 1));
-            for (int dx = -radius; dx <= radius; dx++) {
-                for (int dy = -radius; dy <= radius; dy++) {
-                    if (dx*dx + dy*dy <= radius*radius) {
-                        SDL_Rect pixel = {x + dx, y + dy, 1, 1};
-                        SDL_RenderFillRect(renderer, &pixel);
-                    }
-                }
-            }
-        }
+        glow_cache.draw(batch, x, y, MENU_ORB_GLOW_RADIUS, {130, 170, 255, 255}, alpha);
     }
 }
 
@@ -1399,9 +1385,32 @@ void Game::render_modern_difficulty_selection() {
     float time = SDL_GetTicks() / 1000.0f;
     int base_y = 200;
     
-    // Section title
-    render_text("◢ DIFFICULTY MATRIX ◣", SCREEN_WIDTH/2 - 90, base_y, {200, 255, 200, 255});
+    // Only the selected row animates; the others are in the menu layer
+    int i = difficulty - 1;
+    int y = base_y + 40 + i * 35;
+    
+    // Selection box with futuristic styling
+    float pulse = sin(time * 8) * 0.3f + 0.7f;
+    SDL_Color box_color = {
+        static_cast<Uint8>(100 + 155 * pulse),
+        static_cast<Uint8>(255 * pulse),
+        static_cast<Uint8>(100 + 155 * pulse),
+        200
+    };
+    
+    // Animated border for selected difficulty
+    SDL_Rect border = {SCREEN_WIDTH/2 - 150, y - 5, 300, 25};
+    batch.set_draw_color(box_color.r, box_color.g, box_color.b, 100);
+    batch.fill_rect(&border);
+    
+    // Side indicators
+    render_text("►", SCREEN_WIDTH/2 - 170, y, box_color);
+    render_text("◄", SCREEN_WIDTH/2 + 160, y, box_color);
     
+    render_difficulty_row(i, box_color);
+}
+
+void Game::render_difficulty_row(int index, SDL_Color color) {
     const char* difficulty_names[] = {"APPRENTICE", "WARRIOR", "LEGEND"};
     const char* difficulty_keys[] = {"[1]", "[2]", "[3]"};
     const char* difficulty_desc[] = {
@@ -1409,79 +1418,50 @@ void Game::render_modern_difficulty_selection() {
         "Balanced challenge", 
         "Ultimate test"
     };
-    
-    for (int i = 0; i < 3; i++) {
-        bool selected = (difficulty == (i + 1));
-        int y = base_y + 40 + i * 35;
-        
-        // Selection box with futuristic styling
-        SDL_Color box_color;
-        if (selected) {
-            float pulse = sin(time * 8) * 0.3f + 0.7f;
-            box_color = {
-                static_cast<Uint8>(100 + 155 * pulse),
-                static_cast<Uint8>(255 * pulse),
-                static_cast<Uint8>(100 + 155 * pulse),
-                200
-            };
-            
-            // Animated border for selected difficulty
-            SDL_Rect border = {SCREEN_WIDTH/2 - 150, y - 5, 300, 25};
-            SDL_SetRenderDrawColor(renderer, box_color.r, box_color.g, box_color.b, 100);
-            SDL_RenderFillRect(renderer, &border);
-            
-            // Side indicators
-            render_text("►", SCREEN_WIDTH/2 - 170, y, box_color);
-            render_text("◄", SCREEN_WIDTH/2 + 160, y, box_color);
-        } else {
-            box_color = {120, 120, 150, 255};
-        }
-        
-        // Difficulty name and key
-        render_text(difficulty_keys[i], SCREEN_WIDTH/2 - 140, y, box_color);
-        render_text(difficulty_names[i], SCREEN_WIDTH/2 - 110, y, box_color);
-        render_text(difficulty_desc[i], SCREEN_WIDTH/2 - 10, y, {150, 150, 170, 255});
-    }
-}
+    int y = 200 + 40 + index * 35;
+    
+    // Difficulty name and key
+    render_text(difficulty_keys[index], SCREEN_WIDTH/2 - 140, y, color);
+    render_text(difficulty_names[index], SCREEN_WIDTH/2 - 110, y, color);
+    render_text(difficulty_desc[index], SCREEN_WIDTH/2 - 10, y, {150, 150, 170, 255});
+}
+
+// Power core showcase entries, shared by the animated names and the static
+// effect lines in the menu layer
+struct MenuFoodInfo {
+    const char* name;
+    const char* effect;
+    SDL_Color color;
+    const char* symbol;
+};
+
+static const MenuFoodInfo MENU_FOODS[] = {
+    {"BASIC", "Standard Growth", {100, 255, 100, 255}, "●"},
+    {"VELOCITY", "Speed Boost x1.6", {255, 255, 100, 255}, "⚡"},
+    {"AMPLIFY", "Double Score x8s", {100, 255, 255, 255}, "◆"},
+    {"AURUM", "Golden Bonus x3", {255, 215, 0, 255}, "★"},
+    {"COMPACT", "Size Reduction", {255, 100, 255, 255}, "◇"},
+    {"PHANTOM", "Phase Through", {150, 100, 255, 255}, "◈"},
+    {"OMEGA", "Mega Bonus x5", {255, 100, 100, 255}, "⬟"}
+};
 
 void Game::render_interactive_food_showcase() {
     float time = SDL_GetTicks() / 1000.0f;
     int panel_x = SCREEN_WIDTH + 20;
     int panel_y = 50;
     
-    // Modern panel header
-    render_text("═══ POWER CORES ═══", panel_x, panel_y, {255, 200, 100, 255});
-    
-    struct FoodInfo {
-        const char* name;
-        const char* effect;
-        SDL_Color color;
-        const char* symbol;
-    };
-    
-    FoodInfo foods[] = {
-        {"BASIC", "Standard Growth", {100, 255, 100, 255}, "●"},
-        {"VELOCITY", "Speed Boost x1.6", {255, 255, 100, 255}, "⚡"},
-        {"AMPLIFY", "Double Score x8s", {100, 255, 255, 255}, "◆"},
-        {"AURUM", "Golden Bonus x3", {255, 215, 0, 255}, "★"},
-        {"COMPACT", "Size Reduction", {255, 100, 255, 255}, "◇"},
-        {"PHANTOM", "Phase Through", {150, 100, 255, 255}, "◈"},
-        {"OMEGA", "Mega Bonus x5", {255, 100, 100, 255}, "⬟"}
-    };
-    
     for (int i = 0; i < 7; i++) {
         int y = panel_y + 30 + i * 25;
         float item_glow = sin(time * 2 + i * 0.5f) * 0.3f + 0.7f;
         
-        SDL_Color glow_color = foods[i].color;
+        SDL_Color glow_color = MENU_FOODS[i].color;
         glow_color.r = static_cast<Uint8>(glow_color.r * item_glow);
         glow_color.g = static_cast<Uint8>(glow_color.g * item_glow);
         glow_color.b = static_cast<Uint8>(glow_color.b * item_glow);
         
         // Animated food symbol
-        render_text(foods[i].symbol, panel_x + 5, y, glow_color);
-        render_text(foods[i].name, panel_x + 25, y, glow_color);
-        render_text(foods[i].effect, panel_x + 25, y + 12, {180, 180, 200, 255});
+        render_text(MENU_FOODS[i].symbol, panel_x + 5, y, glow_color);
+        render_text(MENU_FOODS[i].name, panel_x + 25, y, glow_color);
     }
 }
 
@@ -1499,12 +1479,27 @@ void Game::render_info_panel() {
         255
     };
     render_text(high_score_text, panel_x, panel_y, score_color);
+}
+
+// This week's best runs at the selected difficulty, from the local leaderboard
+void Game::render_leaderboard_panel() {
+    const size_t rows = 5;
+    int panel_x = SCREEN_WIDTH + 20;
+    int panel_y = 290;
+    render_text("═══ WEEK TOP 5 ═══", panel_x, panel_y, {255, 200, 100, 255});
     
-    // Achievement info
-    int unlocked = achievement_system->get_unlocked_count();
-    int total = achievement_system->get_total_count();
-    std::string achievement_text = "◇ ACHIEVEMENTS: " + std::to_string(unlocked) + "/" + std::to_string(total) + " ◇";
-    render_text(achievement_text, panel_x - 20, panel_y + 25, {150, 255, 150, 255});
+    const std::vector<ScoreRecord>& top = score_store.get_top(difficulty, SCORE_WINDOW_WEEK,
+                                                              static_cast<uint64_t>(time(nullptr)));
+    if (top.empty()) {
+        render_text("NO RUNS YET", panel_x + 25, panel_y + 30, {150, 150, 170, 255});
+        return;
+    }
+    for (size_t i = 0; i < top.size() && i < rows; i++) {
+        std::string row = "#" + std::to_string(i + 1) + "  " + std::to_string(top[i].score) +
+                          " PTS  LV " + std::to_string(top[i].level);
+        SDL_Color color = i == 0 ? SDL_Color{255, 215, 0, 255} : SDL_Color{180, 180, 200, 255};
+        render_text(row, panel_x + 5, panel_y + 30 + static_cast<int>(i) * 25, color);
+    }
 }
 
 void Game::render_futuristic_controls() {
@@ -1521,8 +1516,35 @@ void Game::render_futuristic_controls() {
     };
     
     render_text("▶ PRESS [SPACE] TO INITIALIZE ◀", SCREEN_WIDTH/2 - 130, y, start_color);
+}
+
+// Everything on the menu that only changes with the difficulty selection or
+// when records and achievements are updated
+void Game::render_menu_static_layer() {
+    // Section title
+    render_text("◢ DIFFICULTY MATRIX ◣", SCREEN_WIDTH/2 - 90, 200, {200, 255, 200, 255});
+    for (int i = 0; i < 3; i++) {
+        if (difficulty != (i + 1)) {
+            render_difficulty_row(i, {120, 120, 150, 255});
+        }
+    }
+    
+    // Power core panel header and effect lines
+    int panel_x = SCREEN_WIDTH + 20;
+    int panel_y = 50;
+    render_text("═══ POWER CORES ═══", panel_x, panel_y, {255, 200, 100, 255});
+    for (int i = 0; i < 7; i++) {
+        render_text(MENU_FOODS[i].effect, panel_x + 25, panel_y + 30 + i * 25 + 12, {180, 180, 200, 255});
+    }
+    
+    // Achievement info
+    int unlocked = achievement_system->get_unlocked_count();
+    int total = achievement_system->get_total_count();
+    std::string achievement_text = "◇ ACHIEVEMENTS: " + std::to_string(unlocked) + "/" + std::to_string(total) + " ◇";
+    render_text(achievement_text, SCREEN_WIDTH/2 - 120, 375, {150, 255, 150, 255});
     
     // Controls hint
+    int y = SCREEN_HEIGHT - 80;
     render_text("WASD / Arrow Keys = Navigation | ESC = System Menu", 
                 SCREEN_WIDTH/2 - 180, y + 25, {120, 150, 180, 255});
     
@@ -1531,23 +1553,54 @@ void Game::render_futuristic_controls() {
                 SCREEN_WIDTH/2 - 120, y + 45, {100, 120, 140, 255});
 }
 
+// Sidebar content that changes with game state rather than every frame
+void Game::render_hud_static_layer(int ui_x) {
+    // Professional HUD header
+    render_text("═══ MISSION DATA ═══", ui_x, 10, {100, 200, 255, 255});
+    
+    render_level_progress(ui_x, 70);
+    
+    // Snake status
+    SDL_Color length_color = {100, 255, 100, 255};
+    int label_width = render_label("◇ LENGTH: ", ui_x, 140, length_color);
+    render_number(snapshot->get_snake().get_length(), ui_x + label_width, 140, length_color);
+    
+    render_combo_streak(ui_x, 170);
+    render_power_up_indicators();
+}
+
+Game::HudLayerState Game::get_hud_layer_state() const {
+    const PowerUps& power_ups = snapshot->get_power_ups();
+    HudLayerState hud_state;
+    hud_state.length = snapshot->get_snake().get_length();
+    hud_state.level = snapshot->get_level();
+    hud_state.foods_eaten = snapshot->get_foods_eaten();
+    hud_state.foods_needed = snapshot->get_foods_needed_for_level();
+    hud_state.combo_multiplier = power_ups.combo_multiplier;
+    hud_state.combo_count = power_ups.combo_count;
+    hud_state.power_up_flags = (power_ups.is_speed_active() ? 1 : 0) |
+                               (power_ups.is_double_score_active() ? 2 : 0) |
+                               (power_ups.is_phase_active() ? 4 : 0);
+    return hud_state;
+}
+
 // Enhanced Snake Rendering System
 void Game::render_futuristic_snake_head(SDL_Rect rect, float time) {
     // Determine head direction for proper eye positioning
-    Direction head_dir = snake.direction;
+    Direction head_dir = snapshot->get_snake().direction;
     
     // Base head colors with power-up modifications
     SDL_Color head_color = {80, 255, 120, 255}; // Default green
     SDL_Color glow_color = {40, 200, 80, 180};
     
     // Power-up color modifications
-    if (power_ups.is_speed_active()) {
+    if (snapshot->get_power_ups().is_speed_active()) {
         head_color = {255, 220, 80, 255}; // Golden yellow
         glow_color = {255, 200, 0, 180};
-    } else if (power_ups.is_phase_active()) {
+    } else if (snapshot->get_power_ups().is_phase_active()) {
         head_color = {180, 80, 255, 255}; // Purple
         glow_color = {150, 0, 255, 180};
-    } else if (power_ups.is_double_score_active()) {
+    } else if (snapshot->get_power_ups().is_double_score_active()) {
         head_color = {80, 200, 255, 255}; // Cyan
         glow_color = {0, 150, 255, 180};
     }
@@ -1558,42 +1611,34 @@ void Game::render_futuristic_snake_head(SDL_Rect rect, float time) {
     head_color.g = static_cast<Uint8>(head_color.g * pulse);
     head_color.b = static_cast<Uint8>(head_color.b * pulse);
     
-    // Multiple layer rendering for depth
-    for (int layer = 3; layer >= 0; layer--) {
-        SDL_Rect layer_rect = {
-            rect.x - layer,
-            rect.y - layer,
-            rect.w + layer * 2,
-            rect.h + layer * 2
-        };
-        
-        if (layer == 0) {
-            // Core head
-            SDL_SetRenderDrawColor(renderer, head_color.r, head_color.g, head_color.b, 255);
-        } else {
-            // Glow layers
-            Uint8 layer_alpha = static_cast<Uint8>(glow_color.a / (layer + 1));
-            SDL_SetRenderDrawColor(renderer, glow_color.r, glow_color.g, glow_color.b, layer_alpha);
-        }
-        
-        SDL_RenderFillRect(renderer, &layer_rect);
-    }
+    // Glow halo, then the core head on top
+    glow_cache.draw(batch, rect.x + rect.w / 2, rect.y + rect.h / 2, HEAD_GLOW_RADIUS, glow_color, glow_color.a);
+    
+    batch.set_draw_color(head_color.r, head_color.g, head_color.b, 255);
+    batch.fill_rect(&rect);
     
     // Advanced directional eyes
     render_snake_eyes(rect, head_dir, time);
     
     // Power-up indicators on head
-    if (power_ups.is_speed_active()) {
+    if (snapshot->get_power_ups().is_speed_active()) {
         render_speed_indicators(rect, time);
     }
     
     // Head outline
-    SDL_SetRenderDrawColor(renderer, 20, 100, 40, 255);
-    SDL_RenderDrawRect(renderer, &rect);
+    batch.set_draw_color(20, 100, 40, 255);
+    batch.draw_rect(&rect);
 }
 
+// Appends one body segment to snake_mesh
 void Game::render_futuristic_snake_body(SDL_Rect rect, size_t segment_index, float time) {
-    float body_ratio = static_cast<float>(segment_index) / snake.segments.size();
+    // Scale dots on a 4px lattice where (x + y) % 8 == 0
+    static const Uint8 scale_offsets[SNAKE_SCALES_PER_SEGMENT][2] = {
+        {0, 0}, {8, 0}, {16, 0}, {4, 4}, {12, 4}, {0, 8}, {8, 8},
+        {16, 8}, {4, 12}, {12, 12}, {0, 16}, {8, 16}, {16, 16}
+    };
+    
+    float body_ratio = static_cast<float>(segment_index) / snapshot->get_snake().get_length();
     float wave_offset = sin(time * 3 + segment_index * 0.5f) * 3;
     
     // Adjust position for organic movement
@@ -1605,36 +1650,31 @@ void Game::render_futuristic_snake_body(SDL_Rect rect, size_t segment_index, flo
     Uint8 base_blue = static_cast<Uint8>(80 + body_ratio * 50);
     
     // Power-up color influences
-    if (power_ups.is_speed_active()) {
+    if (snapshot->get_power_ups().is_speed_active()) {
         base_red = std::min(255, static_cast<int>(base_red * 1.5f));
         base_green = std::min(255, static_cast<int>(base_green * 1.2f));
     }
     
-    if (power_ups.is_phase_active()) {
+    if (snapshot->get_power_ups().is_phase_active()) {
         base_blue = std::min(255, static_cast<int>(base_blue * 1.8f));
         base_red = std::min(255, static_cast<int>(base_red * 1.2f));
     }
     
     // Segmented body rendering
     SDL_Rect main_body = {rect.x + 1, rect.y + 1, rect.w - 2, rect.h - 2};
-    SDL_SetRenderDrawColor(renderer, base_red, base_green, base_blue, 255);
-    SDL_RenderFillRect(renderer, &main_body);
+    SDL_Color body_color = {base_red, base_green, base_blue, 255};
+    snake_mesh.add_rect(main_body, body_color);
     
     // Scale-like texture
-    for (int y = 0; y < rect.h; y += 4) {
-        for (int x = 0; x < rect.w; x += 4) {
-            if ((x + y) % 8 == 0) {
-                Uint8 scale_intensity = static_cast<Uint8>(base_green * 0.8f);
-                SDL_SetRenderDrawColor(renderer, base_red, scale_intensity, base_blue, 150);
-                SDL_Rect scale = {rect.x + x, rect.y + y, 2, 2};
-                SDL_RenderFillRect(renderer, &scale);
-            }
-        }
+    SDL_Color scale_color = {base_red, static_cast<Uint8>(base_green * 0.8f), base_blue, 150};
+    for (int i = 0; i < SNAKE_SCALES_PER_SEGMENT; i++) {
+        SDL_Rect scale = {rect.x + scale_offsets[i][0], rect.y + scale_offsets[i][1], 2, 2};
+        snake_mesh.add_rect(scale, scale_color);
     }
     
     // Body outline
-    SDL_SetRenderDrawColor(renderer, 20, static_cast<Uint8>(base_green * 0.6f), 30, 255);
-    SDL_RenderDrawRect(renderer, &rect);
+    SDL_Color outline_color = {20, static_cast<Uint8>(base_green * 0.6f), 30, 255};
+    snake_mesh.add_outline(rect, outline_color);
 }
 
 void Game::render_snake_eyes(SDL_Rect head_rect, Direction direction, float time) {
@@ -1665,22 +1705,22 @@ void Game::render_snake_eyes(SDL_Rect head_rect, Direction direction, float time
     }
     
     // Eye glow
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
-    SDL_RenderFillRect(renderer, &eye1);
-    SDL_RenderFillRect(renderer, &eye2);
+    batch.set_draw_color(255, 255, 255, 200);
+    batch.fill_rect(&eye1);
+    batch.fill_rect(&eye2);
     
     // Eye pupils
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    batch.set_draw_color(0, 0, 0, 255);
     SDL_Rect pupil1 = {eye1.x + 1, eye1.y + 1, 1, 1};
     SDL_Rect pupil2 = {eye2.x + 1, eye2.y + 1, 1, 1};
-    SDL_RenderFillRect(renderer, &pupil1);
-    SDL_RenderFillRect(renderer, &pupil2);
+    batch.fill_rect(&pupil1);
+    batch.fill_rect(&pupil2);
 }
 
 void Game::render_speed_indicators(SDL_Rect head_rect, float time) {
     // Lightning bolts for speed boost
     float lightning_alpha = sin(time * 10) * 0.5f + 0.5f;
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, static_cast<Uint8>(255 * lightning_alpha));
+    batch.set_draw_color(255, 255, 0, static_cast<Uint8>(255 * lightning_alpha));
     
     // Left lightning bolt
     SDL_Rect bolt1[] = {
@@ -1697,25 +1737,58 @@ void Game::render_speed_indicators(SDL_Rect head_rect, float time) {
     };
     
     for (int i = 0; i < 3; i++) {
-        SDL_RenderFillRect(renderer, &bolt1[i]);
-        SDL_RenderFillRect(renderer, &bolt2[i]);
+        batch.fill_rect(&bolt1[i]);
+        batch.fill_rect(&bolt2[i]);
     }
 }
 
+// Appends the joint between a segment and the one before it to snake_mesh
 void Game::render_snake_joint(size_t segment_index) {
-    if (segment_index == 0 || segment_index >= snake.segments.size()) return;
+    if (segment_index == 0 || segment_index >= segment_positions.size()) return;
+    
+    const SDL_Point& current = segment_positions[segment_index];
+    const SDL_Point& previous = segment_positions[segment_index - 1];
     
-    const Segment& current = snake.segments[segment_index];
-    const Segment& previous = snake.segments[segment_index - 1];
+    // No joint across a phase-mode wrap, the segments are on opposite edges
+    if (std::abs(current.x - previous.x) > GRID_SIZE || std::abs(current.y - previous.y) > GRID_SIZE) return;
     
     // Calculate joint position between segments
-    int joint_x = (current.x + previous.x) * GRID_SIZE / 2;
-    int joint_y = (current.y + previous.y) * GRID_SIZE / 2;
+    int joint_x = (current.x + previous.x) / 2;
+    int joint_y = (current.y + previous.y) / 2;
     
     // Smooth transition joint
-    SDL_SetRenderDrawColor(renderer, 60, 200, 80, 180);
     SDL_Rect joint = {joint_x - 2, joint_y - 2, 4, 4};
-    SDL_RenderFillRect(renderer, &joint);
+    SDL_Color joint_color = {60, 200, 80, 180};
+    snake_mesh.add_rect(joint, joint_color);
+}
+
+// Progress through the current move interval, extrapolated from the
+// snapshot's simulation time by the wall time since it was published
+float Game::get_move_progress() const {
+    float ms_after = 0.0f;
+    if (snapshot->running) {
+        Uint64 since_publish = SDL_GetPerformanceCounter() - snapshot->published_at;
+        ms_after = static_cast<float>(since_publish * 1000.0 / SDL_GetPerformanceFrequency());
+    }
+    return snapshot->get_move_progress(ms_after);
+}
+
+void Game::update_segment_positions(float progress) {
+    const SnakeSnapshot& snake = snapshot->get_snake();
+    segment_positions.resize(snake.get_length());
+    
+    for (size_t i = 0; i < segment_positions.size(); i++) {
+        const Segment& current = snake.get_segment(i);
+        const Segment& previous = snake.get_previous_segment(i);
+        int dx = current.x - previous.x;
+        int dy = current.y - previous.y;
+        
+        // A phase-mode wrap (or a catch-up of several moves) is not a one
+        // cell step; sliding would sweep across the board, so it snaps
+        float remaining = (std::abs(dx) + std::abs(dy) > 1) ? 0.0f : 1.0f - progress;
+        segment_positions[i].x = static_cast<int>((current.x - dx * remaining) * GRID_SIZE + 0.5f);
+        segment_positions[i].y = static_cast<int>((current.y - dy * remaining) * GRID_SIZE + 0.5f);
+    }
 }
 
 // Advanced Food Rendering System
@@ -1724,24 +1797,20 @@ void Game::render_power_core_food(SDL_Rect base_rect, FoodType type, float time)
     float pulse = sin(time * 4) * 0.3f + 0.7f;
     float rotation_offset = time * 2;
     
-    SDL_Color core_color = food.get_color();
+    SDL_Color core_color = get_food_color(snapshot->get_food().type);
     
-    // Multi-layer energy core rendering
-    for (int layer = 4; layer >= 0; layer--) {
-        float layer_scale = 1.0f + (layer * 0.1f * pulse);
-        int layer_size = static_cast<int>(GRID_SIZE * layer_scale);
-        
-        SDL_Rect layer_rect = {
-            base_rect.x + (GRID_SIZE - layer_size) / 2,
-            base_rect.y + (GRID_SIZE - layer_size) / 2,
-            layer_size,
-            layer_size
-        };
-        
-        Uint8 layer_alpha = static_cast<Uint8>(255 / (layer + 1) * pulse);
-        SDL_SetRenderDrawColor(renderer, core_color.r, core_color.g, core_color.b, layer_alpha);
-        SDL_RenderFillRect(renderer, &layer_rect);
-    }
+    // Energy glow, breathing with the pulse, under the solid core
+    int glow_size = static_cast<int>(GRID_SIZE * (1.0f + 0.8f * pulse));
+    SDL_Rect glow_rect = {
+        base_rect.x + (GRID_SIZE - glow_size) / 2,
+        base_rect.y + (GRID_SIZE - glow_size) / 2,
+        glow_size,
+        glow_size
+    };
+    glow_cache.draw(batch, glow_rect, FOOD_GLOW_RADIUS, core_color, static_cast<Uint8>(160 * pulse));
+    
+    batch.set_draw_color(core_color.r, core_color.g, core_color.b, static_cast<Uint8>(255 * pulse));
+    batch.fill_rect(&base_rect);
     
     // Type-specific effects
     render_food_type_effects(base_rect, type, time, rotation_offset);
@@ -1762,13 +1831,13 @@ void Game::render_food_type_effects(SDL_Rect rect, FoodType type, float time, fl
                 int end_x = center_x + static_cast<int>(cos(angle) * 15);
                 int end_y = center_y + static_cast<int>(sin(angle) * 15);
                 
-                SDL_SetRenderDrawColor(renderer, 255, 255, 100, 200);
+                batch.set_draw_color(255, 255, 100, 200);
                 // Simple line approximation
                 for (int j = 0; j < 10; j++) {
                     int x = center_x + (end_x - center_x) * j / 10;
                     int y = center_y + (end_y - center_y) * j / 10;
                     SDL_Rect bolt = {x, y, 2, 2};
-                    SDL_RenderFillRect(renderer, &bolt);
+                    batch.fill_rect(&bolt);
                 }
             }
             break;
@@ -1782,9 +1851,9 @@ void Game::render_food_type_effects(SDL_Rect rect, FoodType type, float time, fl
                     int x = center_x + static_cast<int>(cos(angle) * ring_radius);
                     int y = center_y + static_cast<int>(sin(angle) * ring_radius);
                     
-                    SDL_SetRenderDrawColor(renderer, 100, 255, 255, 150);
+                    batch.set_draw_color(100, 255, 255, 150);
                     SDL_Rect dot = {x - 1, y - 1, 2, 2};
-                    SDL_RenderFillRect(renderer, &dot);
+                    batch.fill_rect(&dot);
                 }
             }
             break;
@@ -1796,9 +1865,9 @@ void Game::render_food_type_effects(SDL_Rect rect, FoodType type, float time, fl
                 int outer_x = center_x + static_cast<int>(cos(angle) * 12);
                 int outer_y = center_y + static_cast<int>(sin(angle) * 12);
                 
-                SDL_SetRenderDrawColor(renderer, 255, 215, 0, 200);
+                batch.set_draw_color(255, 215, 0, 200);
                 SDL_Rect star_point = {outer_x - 1, outer_y - 1, 3, 3};
-                SDL_RenderFillRect(renderer, &star_point);
+                batch.fill_rect(&star_point);
             }
             break;
             
@@ -1810,9 +1879,9 @@ void Game::render_food_type_effects(SDL_Rect rect, FoodType type, float time, fl
                 int x = center_x + static_cast<int>(cos(angle) * spiral_radius);
                 int y = center_y + static_cast<int>(sin(angle) * spiral_radius);
                 
-                SDL_SetRenderDrawColor(renderer, 255, 100, 255, 150);
+                batch.set_draw_color(255, 100, 255, 150);
                 SDL_Rect spiral_dot = {x, y, 1, 1};
-                SDL_RenderFillRect(renderer, &spiral_dot);
+                batch.fill_rect(&spiral_dot);
             }
             break;
             
@@ -1820,14 +1889,14 @@ void Game::render_food_type_effects(SDL_Rect rect, FoodType type, float time, fl
         {
             // Phase shift effect (wrap in braces to avoid variable scope issues)
             float phase_offset = sin(time * 6) * 5;
-            SDL_SetRenderDrawColor(renderer, 150, 100, 255, 100);
+            batch.set_draw_color(150, 100, 255, 100);
             SDL_Rect ghost_rect = {
                 rect.x + static_cast<int>(phase_offset), 
                 rect.y, 
                 rect.w, 
                 rect.h
             };
-            SDL_RenderFillRect(renderer, &ghost_rect);
+            batch.fill_rect(&ghost_rect);
             break;
         }
             
@@ -1841,9 +1910,9 @@ void Game::render_food_type_effects(SDL_Rect rect, FoodType type, float time, fl
                     int y = center_y + static_cast<int>(sin(angle) * wave_radius);
                     
                     Uint8 alpha = static_cast<Uint8>(200 / (wave + 1));
-                    SDL_SetRenderDrawColor(renderer, 255, 100, 100, alpha);
+                    batch.set_draw_color(255, 100, 100, alpha);
                     SDL_Rect energy = {x - 1, y - 1, 2, 2};
-                    SDL_RenderFillRect(renderer, &energy);
+                    batch.fill_rect(&energy);
                 }
             }
             break;
@@ -1857,9 +1926,9 @@ void Game::render_food_type_effects(SDL_Rect rect, FoodType type, float time, fl
                 int x = center_x + static_cast<int>(cos(angle) * ring_radius);
                 int y = center_y + static_cast<int>(sin(angle) * ring_radius);
                 
-                SDL_SetRenderDrawColor(renderer, 100, 255, 100, 120);
+                batch.set_draw_color(100, 255, 100, 120);
                 SDL_Rect dot = {x, y, 1, 1};
-                SDL_RenderFillRect(renderer, &dot);
+                batch.fill_rect(&dot);
             }
             break;
     }
@@ -1868,7 +1937,7 @@ void Game::render_food_type_effects(SDL_Rect rect, FoodType type, float time, fl
 void Game::render_food_energy_particles(SDL_Rect rect, FoodType type, float time) {
     int center_x = rect.x + rect.w / 2;
     int center_y = rect.y + rect.h / 2;
-    SDL_Color core_color = food.get_color();
+    SDL_Color core_color = get_food_color(snapshot->get_food().type);
     
     // Floating energy particles
     for (int i = 0; i < 8; i++) {
@@ -1881,9 +1950,9 @@ void Game::render_food_energy_particles(SDL_Rect rect, FoodType type, float time
         float alpha_mod = (sin(particle_time * 3) + 1) / 2;
         Uint8 alpha = static_cast<Uint8>(150 * alpha_mod);
         
-        SDL_SetRenderDrawColor(renderer, core_color.r, core_color.g, core_color.b, alpha);
+        batch.set_draw_color(core_color.r, core_color.g, core_color.b, alpha);
         SDL_Rect particle = {x - 1, y - 1, 2, 2};
-        SDL_RenderFillRect(renderer, &particle);
+        batch.fill_rect(&particle);
     }
 }
 
@@ -1891,27 +1960,29 @@ void Game::render_food_energy_particles(SDL_Rect rect, FoodType type, float time
 void Game::render_level_display(int x, int y, float time) {
     // Animated level indicator
     float level_glow = sin(time * 2) * 0.3f + 0.7f;
-    std::string level_text = "◆ LEVEL: " + std::to_string(level);
     SDL_Color level_color = {
         static_cast<Uint8>(100 + 155 * level_glow),
         static_cast<Uint8>(255 * level_glow),
         static_cast<Uint8>(100 + 155 * level_glow),
         255
     };
-    render_text(level_text, x, y, level_color);
-    
+    int label_width = render_label("◆ LEVEL: ", x, y, level_color);
+    render_number(snapshot->get_level(), x + label_width, y, level_color);
+}
+
+void Game::render_level_progress(int x, int y) {
     // Progress bar
     int bar_width = 150;
     int bar_height = 8;
     int bar_y = y + 20;
     
     // Background
-    SDL_SetRenderDrawColor(renderer, 40, 40, 60, 200);
+    batch.set_draw_color(40, 40, 60, 200);
     SDL_Rect bg_bar = {x, bar_y, bar_width, bar_height};
-    SDL_RenderFillRect(renderer, &bg_bar);
+    batch.fill_rect(&bg_bar);
     
     // Progress fill
-    float progress = static_cast<float>(foods_eaten) / foods_needed_for_level;
+    float progress = static_cast<float>(snapshot->get_foods_eaten()) / snapshot->get_foods_needed_for_level();
     int fill_width = static_cast<int>(bar_width * progress);
     
     for (int i = 0; i < fill_width; i++) {
@@ -1920,22 +1991,22 @@ void Game::render_level_display(int x, int y, float time) {
         Uint8 g = static_cast<Uint8>(255 - 100 * gradient);
         Uint8 b = static_cast<Uint8>(100 + 155 * (1 - gradient));
         
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+        batch.set_draw_color(r, g, b, 255);
         SDL_Rect fill = {x + i, bar_y, 1, bar_height};
-        SDL_RenderFillRect(renderer, &fill);
+        batch.fill_rect(&fill);
     }
     
     // Progress text
-    std::string progress_text = std::to_string(foods_eaten) + "/" + std::to_string(foods_needed_for_level);
+    std::string progress_text = std::to_string(snapshot->get_foods_eaten()) + "/" + std::to_string(snapshot->get_foods_needed_for_level());
     render_text(progress_text, x + bar_width + 10, y + 15, {180, 180, 220, 255});
 }
 
 void Game::render_combo_display(int x, int y, float time) {
-    if (power_ups.combo_multiplier <= 1) return;
+    if (snapshot->get_power_ups().combo_multiplier <= 1) return;
     
     // Spectacular combo display
     float combo_pulse = sin(time * 8) * 0.4f + 0.6f;
-    std::string combo_text = "⚡ COMBO x" + std::to_string(power_ups.combo_multiplier) + " ⚡";
+    std::string combo_text = "⚡ COMBO x" + std::to_string(snapshot->get_power_ups().combo_multiplier) + " ⚡";
     SDL_Color combo_color = {
         static_cast<Uint8>(255 * combo_pulse),
         static_cast<Uint8>(255 * combo_pulse),
@@ -1943,12 +2014,16 @@ void Game::render_combo_display(int x, int y, float time) {
         255
     };
     render_text(combo_text, x, y, combo_color);
+}
+
+void Game::render_combo_streak(int x, int y) {
+    if (snapshot->get_power_ups().combo_multiplier <= 1) return;
     
     // Combo streak visualization
-    for (int i = 0; i < power_ups.combo_count && i < 10; i++) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 100, 200);
+    for (int i = 0; i < snapshot->get_power_ups().combo_count && i < 10; i++) {
+        batch.set_draw_color(255, 255, 100, 200);
         SDL_Rect streak = {x + i * 8, y + 20, 6, 6};
-        SDL_RenderFillRect(renderer, &streak);
+        batch.fill_rect(&streak);
     }
 }
 
@@ -1957,10 +2032,6 @@ void Game::render_mission_timer(int x, int y, float time) {
     int minutes = game_time / 60;
     int seconds = game_time % 60;
     
-    std::string time_text = std::string("⏱ TIME: ") + 
-                           (minutes < 10 ? "0" : "") + std::to_string(minutes) + ":" + 
-                           (seconds < 10 ? "0" : "") + std::to_string(seconds);
-    
     float time_pulse = sin(time * 1.5f) * 0.2f + 0.8f;
     SDL_Color time_color = {
         static_cast<Uint8>(200 * time_pulse),
@@ -1968,7 +2039,41 @@ void Game::render_mission_timer(int x, int y, float time) {
         static_cast<Uint8>(200 * time_pulse),
         255
     };
-    render_text(time_text, x, y, time_color);
+    int pen_x = x + render_label("⏱ TIME: ", x, y, time_color);
+    pen_x += render_number(minutes, pen_x, y, time_color, 2);
+    pen_x += render_label(":", pen_x, y, time_color);
+    render_number(seconds, pen_x, y, time_color, 2);
+}
+
+void Game::render_debug_info(int x, int y) {
+    // Input-to-move latency, measured by the sim for every applied turn
+    const InputLatencyStats& latency = snapshot->get_input_latency();
+    std::string latency_text = "INPUT LAG: " + std::to_string(latency.last) + " ms";
+    std::string latency_detail = "avg " + std::to_string(static_cast<int>(latency.get_average() + 0.5f)) +
+                                 " / max " + std::to_string(latency.max) + " ms";
+    render_text(latency_text, x, y, {150, 150, 170, 255});
+    render_text(latency_detail, x, y + 18, {150, 150, 170, 255});
+    
+    // Counters from the last presented frame
+    std::string draw_text = "DRAWS: " + std::to_string(last_frame_stats.submitted_draws) +
+                            " -> " + std::to_string(last_frame_stats.draw_calls) + " calls";
+    std::string background_text = "BG DRAWS: " + std::to_string(last_frame_stats.background_draw_calls);
+    render_text(draw_text, x, y + 36, {150, 150, 170, 255});
+    render_text(background_text, x, y + 54, {150, 150, 170, 255});
+    
+    // How far moves ran behind their tick schedule
+    const TickTimingStats& ticks = snapshot->get_tick_timing();
+    std::string tick_text = "MOVE LAG: " + std::to_string(static_cast<int>(ticks.get_average() + 0.5f)) +
+                            " / max " + std::to_string(ticks.max_lag) + " us";
+    std::string late_text = "LATE MOVES: " + std::to_string(ticks.late_ticks) + " / " + std::to_string(ticks.ticks);
+    render_text(tick_text, x, y + 72, {150, 150, 170, 255});
+    render_text(late_text, x, y + 90, {150, 150, 170, 255});
+    
+    // Sound effect request until its first buffer is mixed and queued
+    AudioLatencyStats audio = voices.get_latency();
+    std::string audio_text = "AUDIO LAG: " + std::to_string((audio.last + 500) / 1000) +
+                             " / max " + std::to_string((audio.max + 500) / 1000) + " ms";
+    render_text(audio_text, x, y + 108, {150, 150, 170, 255});
 }
 
 // Epic Game Over Screen System
@@ -1982,16 +2087,15 @@ void Game::render_game_over_background(float time) {
         Uint8 g = static_cast<Uint8>(5 + (15 * gradient));
         Uint8 b = static_cast<Uint8>(20 + (40 * gradient) + (30 * wave));
         
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-        SDL_Rect line = {0, y, SCREEN_WIDTH + 200, 1};
-        SDL_RenderFillRect(renderer, &line);
+        background_strip.set_row(y, r, g, b);
     }
+    frame_stats.background_draw_calls += background_strip.draw(batch, SCREEN_WIDTH + 200);
     
     // Dramatic overlay
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 150);
+    batch.set_blend_mode(SDL_BLENDMODE_BLEND);
+    batch.set_draw_color(0, 0, 0, 150);
     SDL_Rect overlay = {0, 0, SCREEN_WIDTH + 200, SCREEN_HEIGHT};
-    SDL_RenderFillRect(renderer, &overlay);
+    batch.fill_rect(&overlay);
     
     // Floating debris particles
     for (int i = 0; i < 20; i++) {
@@ -2000,16 +2104,16 @@ void Game::render_game_over_background(float time) {
         int y = static_cast<int>(30 + (SCREEN_HEIGHT - 60) * (cos(particle_time * 0.07f) + 1) / 2);
         
         float alpha = (sin(particle_time) + 1) / 2 * 100;
-        SDL_SetRenderDrawColor(renderer, 150, 50, 50, static_cast<Uint8>(alpha));
+        batch.set_draw_color(150, 50, 50, static_cast<Uint8>(alpha));
         SDL_Rect debris = {x, y, 3, 3};
-        SDL_RenderFillRect(renderer, &debris);
+        batch.fill_rect(&debris);
     }
 }
 
 void Game::render_epic_game_over_title(float time) {
     // Dramatic "MISSION COMPLETE" or "MISSION FAILED"
-    std::string title = score > 100 ? "MISSION COMPLETE" : "MISSION TERMINATED";
-    SDL_Color title_color = score > 100 ? 
+    std::string title = snapshot->get_score() > 100 ? "MISSION COMPLETE" : "MISSION TERMINATED";
+    SDL_Color title_color = snapshot->get_score() > 100 ? 
         SDL_Color{100, 255, 100, 255} : 
         SDL_Color{255, 100, 100, 255};
     
@@ -2039,18 +2143,18 @@ void Game::render_game_over_statistics(float time) {
     int panel_y = SCREEN_HEIGHT/2 - 80;
     
     // Statistics panel background
-    SDL_SetRenderDrawColor(renderer, 20, 30, 50, 200);
+    batch.set_draw_color(20, 30, 50, 200);
     SDL_Rect panel = {panel_x - 10, panel_y - 10, 300, 160};
-    SDL_RenderFillRect(renderer, &panel);
+    batch.fill_rect(&panel);
     
     // Panel border
-    SDL_SetRenderDrawColor(renderer, 100, 150, 200, 255);
-    SDL_RenderDrawRect(renderer, &panel);
+    batch.set_draw_color(100, 150, 200, 255);
+    batch.draw_rect(&panel);
     
     // Statistics with animated reveals
     float stat_glow = sin(time * 3) * 0.2f + 0.8f;
     
-    std::string score_text = "◈ FINAL SCORE: " + std::to_string(score);
+    std::string score_text = "◈ FINAL SCORE: " + std::to_string(snapshot->get_score());
     SDL_Color score_color = {
         static_cast<Uint8>(255 * stat_glow),
         static_cast<Uint8>(215 * stat_glow),
@@ -2058,10 +2162,10 @@ void Game::render_game_over_statistics(float time) {
     };
     render_text(score_text, panel_x, panel_y, score_color);
     
-    std::string level_text = "◆ LEVEL REACHED: " + std::to_string(level);
+    std::string level_text = "◆ LEVEL REACHED: " + std::to_string(snapshot->get_level());
     render_text(level_text, panel_x, panel_y + 25, {100, 255, 100, 255});
     
-    std::string length_text = "◇ MAXIMUM LENGTH: " + std::to_string(snake.get_length());
+    std::string length_text = "◇ MAXIMUM LENGTH: " + std::to_string(snapshot->get_snake().get_length());
     render_text(length_text, panel_x, panel_y + 50, {150, 200, 255, 255});
     
     Uint32 game_time = (SDL_GetTicks() - game_start_time) / 1000;
@@ -2074,6 +2178,12 @@ void Game::render_game_over_statistics(float time) {
     
     std::string games_text = "◉ TOTAL MISSIONS: " + std::to_string(game_stats->games_played);
     render_text(games_text, panel_x, panel_y + 100, {200, 200, 255, 255});
+    
+    if (run_rank > 0) {
+        std::string rank_text = "🏆 RANK: #" + std::to_string(run_rank) + " / " + std::to_string(run_rank_total) +
+                                " (#" + std::to_string(run_week_rank) + " THIS WEEK)";
+        render_text(rank_text, panel_x, panel_y + 125, {255, 215, 0, 255});
+    }
 }
 
 void Game::render_achievement_showcase(float time) {
@@ -2092,9 +2202,9 @@ void Game::render_achievement_showcase(float time) {
     int bar_y = panel_y + 25;
     
     // Background bar
-    SDL_SetRenderDrawColor(renderer, 40, 40, 60, 200);
+    batch.set_draw_color(40, 40, 60, 200);
     SDL_Rect bg_bar = {bar_x, bar_y, bar_width, bar_height};
-    SDL_RenderFillRect(renderer, &bg_bar);
+    batch.fill_rect(&bg_bar);
     
     // Progress fill with animation
     float progress = static_cast<float>(unlocked_count) / total_count;
@@ -2108,9 +2218,9 @@ void Game::render_achievement_showcase(float time) {
         Uint8 g = static_cast<Uint8>(215 * pulse);
         Uint8 b = static_cast<Uint8>(0);
         
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+        batch.set_draw_color(r, g, b, 255);
         SDL_Rect fill = {bar_x + i, bar_y, 1, bar_height};
-        SDL_RenderFillRect(renderer, &fill);
+        batch.fill_rect(&fill);
     }
     
     // Achievement text
@@ -2129,13 +2239,13 @@ void Game::render_high_score_celebration(float time) {
         int x = SCREEN_WIDTH/2 + static_cast<int>(cos(angle) * radius);
         int y = SCREEN_HEIGHT/2 - 200 + static_cast<int>(sin(angle) * radius);
         
-        SDL_SetRenderDrawColor(renderer, 
+        batch.set_draw_color(
                              255, 
                              static_cast<Uint8>(255 * celebration_intensity),
                              static_cast<Uint8>(100 * celebration_intensity),
                              200);
         SDL_Rect spark = {x - 2, y - 2, 4, 4};
-        SDL_RenderFillRect(renderer, &spark);
+        batch.fill_rect(&spark);
     }
     
     // Celebration text
@@ -15,17 +15,70 @@
 #include <vector>
 #include <memory>
 
+#include "sim/snake_sim.h"
+#include "sim_thread.h"
+#include "config.h"
+#include "particles.h"
+#include "render_batch.h"
+#include "glyph_atlas.h"
+#include "gradient_strip.h"
+#include "glow_cache.h"
+#include "render_layer.h"
+#include "sprite_atlas.h"
+#include "asset_archive.h"
+#include "asset_loader.h"
+#include "voice_pool.h"
+#include "save_writer.h"
+#include "stats_journal.h"
+#include "score_store.h"
+
 // Forward declarations
 struct GameStats;
 class AchievementSystem;
 
 // Configuration constants
-const int SCREEN_WIDTH = 800;
-const int SCREEN_HEIGHT = 600;
 const int GRID_SIZE = 20;
-const int GRID_WIDTH = SCREEN_WIDTH / GRID_SIZE;
-const int GRID_HEIGHT = SCREEN_HEIGHT / GRID_SIZE;
-const int MAX_PARTICLES = 100;
+const int SCREEN_WIDTH = GRID_WIDTH * GRID_SIZE;
+const int SCREEN_HEIGHT = GRID_HEIGHT * GRID_SIZE;
+const int MAX_PARTICLES = 100;             // Default pool size; config PARTICLE_COUNT overrides
+const int PARTICLE_COUNT_LIMIT = 65536;
+const int LOADING_PARTICLES = 64;
+
+// Radial glow sprite sizes (see GlowCache)
+const int DATA_NODE_GLOW_RADIUS = 3;
+const int MENU_ORB_GLOW_RADIUS = 8;
+const int FOOD_GLOW_RADIUS = GRID_SIZE;
+const int HEAD_GLOW_RADIUS = GRID_SIZE / 2 + 3;
+
+// Body segment quads: fill, scale dots, outline edges and the joint
+const int SNAKE_SCALES_PER_SEGMENT = 13;
+const int SNAKE_QUADS_PER_SEGMENT = 1 + SNAKE_SCALES_PER_SEGMENT + 4 + 1;
+
+// Height of the sprite digits drawn next to the HUD labels
+const int HUD_DIGIT_HEIGHT = 20;
+
+// Fixed simulation timestep: the rules advance in exact 1 ms ticks,
+// matching the millisecond resolution of every gameplay timer
+const Uint32 SIM_TICK_MS = 1;
+const Uint32 MAX_FRAME_CATCH_UP_MS = 250; // Drop time beyond this after a stall
+
+// Startup asset decoding (see AssetLoader)
+const int ASSET_LOADER_MAX_THREADS = 4;
+// Audio device: 44.1 kHz stereo, buffer in sample frames
+const int AUDIO_FREQUENCY = 44100;
+const int AUDIO_BUFFER_FRAMES = 2048;      // Default, about 46 ms
+const int LOW_LATENCY_BUFFER_FRAMES = 256; // LOW_LATENCY_AUDIO default, about 6 ms
+const int SFX_VOICES = 16;
+
+const char* const ASSET_ARCHIVE_PATH = "data/assets.pak";  // Built by make pack
+const char* const REPLAY_DIR = "replays/";                  // One .snkr file per game (see sim/replay.h)
+
+enum AssetId {
+    ASSET_ID_BACKGROUND,
+    ASSET_ID_LOADING_SCREEN,
+    ASSET_ID_MUSIC,
+    ASSET_ID_GAME_OVER_MUSIC
+};
 
 // Game states
 enum GameState {
@@ -42,96 +95,14 @@ enum Difficulty {
     DIFFICULTY_HARD = 3
 };
 
-// Direction enum
-enum Direction {
-    DIR_UP,
-    DIR_DOWN,
-    DIR_LEFT,
-    DIR_RIGHT
-};
-
-// Food types for magical power system
-enum FoodType {
-    FOOD_NORMAL,      // Regular food, grows snake
-    FOOD_SPEED,       // Temporary speed boost
-    FOOD_DOUBLE,      // Double score for next few foods
-    FOOD_GOLDEN,      // High score bonus
-    FOOD_SHRINK,      // Shrinks snake by 1-2 segments
-    FOOD_PHASE,       // Temporary wall phasing ability
-    FOOD_MEGA,        // Massive score bonus, very rare
-    FOOD_TYPE_COUNT
-};
-
-// Snake segment
-struct Segment {
-    int x, y;
-};
-
-// Snake structure
-struct Snake {
-    std::vector<Segment> segments;
-    Direction direction;
-    Direction next_direction;
+// Per-frame rendering counters, reset at the start of every frame
+struct FrameStats {
+    int background_draw_calls;
+    int submitted_draws;   // Primitives queued on the render batch
+    int draw_calls;        // SDL_RenderGeometry calls after batching
     
-    Snake();
-    ~Snake() = default;
-    void init();
-    void move();
-    bool check_collision(bool phase_mode = false);
-    void grow();
-    void shrink(int amount = 1);
-    void change_direction(Direction new_dir);
-    int get_length() const { return segments.size(); }
-};
-
-// Food structure
-struct Food {
-    int x, y;
-    bool active;
-    FoodType type;
-    float spawn_time;
-    float pulse_phase;
-    float glow_intensity;
-    
-    Food();
-    void spawn(const Snake& snake);
-    bool check_collision(const Snake& snake);
-    FoodType get_random_type(int level, int foods_eaten);
-    SDL_Color get_color() const;
-};
-
-// Power-up states
-struct PowerUps {
-    bool speed_boost;
-    bool double_score;
-    bool phase_through_walls;
-    Uint32 speed_end_time;
-    Uint32 double_score_end_time;
-    Uint32 phase_end_time;
-    int combo_multiplier;
-    int combo_count;
-    Uint32 last_food_time;
-    
-    PowerUps();
-    void init();
-    void update(Uint32 current_time);
-    bool is_speed_active() const { return speed_boost; }
-    bool is_double_score_active() const { return double_score; }
-    bool is_phase_active() const { return phase_through_walls; }
-    int get_score_multiplier() const;
-};
-
-// Particle for visual effects
-struct Particle {
-    float x, y;
-    float vx, vy;
-    float life;
-    float max_life;
-    Uint8 r, g, b, a;
-    
-    Particle() : x(0), y(0), vx(0), vy(0), life(0), max_life(1.0f), r(255), g(255), b(255), a(255) {}
-    void update(float dt);
-    bool is_alive() const { return life > 0; }
+    FrameStats() : background_draw_calls(0), submitted_draws(0), draw_calls(0) {}
+    void reset() { background_draw_calls = submitted_draws = draw_calls = 0; }
 };
 
 // Main Game class
@@ -141,6 +112,8 @@ private:
     SDL_Renderer* renderer;
     TTF_Font* font;
     TTF_Font* large_font;
+    GlyphAtlas* font_atlas;
+    GlyphAtlas* large_font_atlas;
     
     // Audio
     Mix_Music* background_music;
@@ -150,42 +123,85 @@ private:
     Mix_Chunk* power_up_sound;
     Mix_Chunk* level_up_sound;
     std::vector<Mix_Chunk*> sound_effects;
+    VoicePool voices;             // Sound effects are played through this
+    
+    // Images and sounds decoded in the background, collected each frame;
+    // the packed archive, when present, replaces most of that decoding
+    AssetArchive asset_archive;
+    AssetLoader asset_loader;
     
     // Textures
     SDL_Texture* bg_texture;
     SDL_Texture* loading_texture;
-    std::vector<SDL_Texture*> score_textures;
-    std::vector<SDL_Texture*> letter_textures;
+    SpriteAtlas* char_sprites;  // Snake digits and letters, one packed texture
+    GradientStrip background_strip;
+    GlowCache glow_cache;
+    
+    // Every render_* function draws through the batch; it is flushed once
+    // per frame in present_frame()
+    RenderBatch batch;
+    QuadMesh snake_mesh;  // Whole body, rebuilt each frame into reused buffers
+    std::vector<SDL_Point> segment_positions;  // Interpolated pixel positions, head first
+    FrameStats frame_stats;
+    FrameStats last_frame_stats;
+    
+    // Values shown in the cached sidebar layer; any change redraws it
+    struct HudLayerState {
+        int length, level, foods_eaten, foods_needed;
+        int combo_multiplier, combo_count;
+        int power_up_flags;
+        
+        HudLayerState() : length(-1), level(0), foods_eaten(0), foods_needed(0),
+                          combo_multiplier(0), combo_count(0), power_up_flags(0) {}
+        bool operator==(const HudLayerState& other) const {
+            return length == other.length && level == other.level &&
+                   foods_eaten == other.foods_eaten && foods_needed == other.foods_needed &&
+                   combo_multiplier == other.combo_multiplier && combo_count == other.combo_count &&
+                   power_up_flags == other.power_up_flags;
+        }
+    };
     
-    // Game objects
-    Snake snake;
-    Food food;
-    PowerUps power_ups;
-    std::vector<Particle> particles;
+    // Slow-changing content cached in render targets
+    RenderLayer grid_layer;
+    RenderLayer hud_layer;
+    RenderLayer menu_layer;
+    HudLayerState hud_layer_state;
+    
+    // Game objects: the simulation runs on its own thread, drawing and
+    // event handling read the newest snapshot it published
+    SimThread sim_thread;
+    const SimSnapshot* snapshot;
+    uint32_t handled_event_seq;    // Next snapshot event to react to
+    ParticlePool particles;
+    int particle_burst_scale;  // Bursts grow with the pool so big pools get used
+    
+    // Cosmetic randomness (particles, shake), never fed back into the sim
+    Prng effects_rng;
     
     // Achievement system
+    SaveWriter save_writer;       // High score, stats and achievements go to disk on its thread
+    StatsJournal stats_journal;   // Per-game records behind GameStats and the unlocks
+    ScoreStore score_store;       // Every run, for ranks and leaderboards
+    uint32_t run_rank;            // Last run among all runs of its difficulty
+    uint32_t run_rank_total;
+    uint32_t run_week_rank;
     GameStats* game_stats;
     AchievementSystem* achievement_system;
     
     // Game state
     GameState state;
     Difficulty difficulty;
-    int score;
     int high_score;
     bool running;
-    
-    // Level system
-    int level;
-    int foods_needed_for_level;
-    int base_score_per_food;
-    int foods_eaten;
-    int special_foods_eaten;
     Uint32 game_start_time;
     
     // Timing
-    Uint32 last_move_time;
-    Uint32 move_delay;
+    Config config;
     Uint32 base_move_delay;
+    int fps_target;
+    bool vsync_enabled;
+    bool show_debug_info;
+    bool smooth_movement;          // Slide the snake between cells instead of jumping
     
     // Visual effects
     float food_pulse;
@@ -196,7 +212,7 @@ private:
     // Enhanced loading screen effects
     float loading_progress;
     Uint32 loading_start_time;
-    std::vector<Particle> loading_particles;
+    ParticlePool loading_particles;
     
 public:
     Game();
@@ -207,20 +223,25 @@ public:
     void run();
     void handle_events();
     void update();
+    void update_effects(float dt);
     void render();
+    void present_frame();
+    void wait_for_frame(Uint64 deadline);
     void reset();
     
     // Audio management
     bool load_audio();
-    void play_sound(int sound_id);
+    void play_sound(int sound_id, SoundPriority priority);
     
     // Texture management  
     bool load_textures();
-    SDL_Texture* load_texture(const std::string& path);
+    void receive_assets();
+    void open_asset_archive();
+    bool has_asset(const std::string& path, PakEntryKind kind) const;
+    TTF_Font* open_font(const std::string& path, int size);
     
     // Game logic
-    void apply_food_effect(FoodType type);
-    void level_up();
+    void handle_sim_event(const SimEvent& event);
     void add_screen_shake(float intensity, Uint32 duration);
     
     // Rendering methods
@@ -234,7 +255,12 @@ public:
     void render_particles();
     void render_power_up_indicators();
     void render_text(const std::string& text, int x, int y, SDL_Color color, TTF_Font* font_to_use = nullptr);
-    void render_gradient_background();
+    int render_label(const std::string& text, int x, int y, SDL_Color color);
+    int render_number(int value, int x, int y, SDL_Color color, int min_digits = 1);
+    GlyphAtlas* get_glyph_atlas(TTF_Font* font_to_use);
+    void render_gradient_background(int shake_x, int shake_y);
+    void render_hud_static_layer(int ui_x);
+    HudLayerState get_hud_layer_state() const;
     
     // Enhanced loading screen methods
     void render_futuristic_background(float progress);
@@ -250,7 +276,10 @@ public:
     void render_modern_difficulty_selection();
     void render_interactive_food_showcase();
     void render_info_panel();
+    void render_leaderboard_panel();
     void render_futuristic_controls();
+    void render_difficulty_row(int index, SDL_Color color);
+    void render_menu_static_layer();
     
     // Enhanced snake rendering
     void render_futuristic_snake_head(SDL_Rect rect, float time);
@@ -258,6 +287,8 @@ public:
     void render_snake_eyes(SDL_Rect head_rect, Direction direction, float time);
     void render_speed_indicators(SDL_Rect head_rect, float time);
     void render_snake_joint(size_t segment_index);
+    float get_move_progress() const;
+    void update_segment_positions(float progress);
     
     // Advanced food rendering
     void render_power_core_food(SDL_Rect base_rect, FoodType type, float time);
@@ -266,8 +297,11 @@ public:
     
     // Professional UI system
     void render_level_display(int x, int y, float time);
+    void render_level_progress(int x, int y);
     void render_combo_display(int x, int y, float time);
+    void render_combo_streak(int x, int y);
     void render_mission_timer(int x, int y, float time);
+    void render_debug_info(int x, int y);
     
     // Epic game over screen
     void render_game_over_background(float time);
@@ -281,11 +315,11 @@ public:
     void add_particle(float x, float y, float vx, float vy, SDL_Color color);
     void spawn_food_particles(float x, float y, FoodType type);
     void spawn_power_up_particles(float x, float y, FoodType type);
-    void update_particles();
+    void update_particles(float dt);
     
     // Utility functions
-    Uint32 get_level_speed(int level, bool speed_boost);
-    int get_level_required_foods(int level);
+    SDL_Color get_food_color(FoodType type) const;
+    uint64_t make_game_seed();
     void save_high_score();
     void load_high_score();
 };
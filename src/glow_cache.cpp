@@ -0,0 +1,80 @@
+#include "glow_cache.h"
+#include <cmath>
+#include <vector>
+
+// Sprites larger than this are refused rather than cached
+static const int MAX_GLOW_RADIUS = 128;
+
+GlowCache::GlowCache() : renderer(nullptr) {
+}
+
+GlowCache::~GlowCache() {
+    clear();
+}
+
+void GlowCache::clear() {
+    for (auto& sprite : sprites) {
+        if (sprite.second) SDL_DestroyTexture(sprite.second);
+    }
+    sprites.clear();
+}
+
+SDL_Texture* GlowCache::build(int radius, Uint8 r, Uint8 g, Uint8 b) {
+    int size = radius * 2 + 1;
+    std::vector<Uint32> pixels(size * size, 0);
+    
+    // Alpha falls off linearly from the centre and is zero past the radius
+    Uint32 rgb = (Uint32(r) << 16) | (Uint32(g) << 8) | b;
+    for (int dy = -radius; dy <= radius; dy++) {
+        for (int dx = -radius; dx <= radius; dx++) {
+            float distance = sqrtf(static_cast<float>(dx * dx + dy * dy));
+            if (distance > radius) continue;
+            
+            float falloff = 1.0f - distance / (radius + 1);
+            Uint32 alpha = static_cast<Uint32>(255 * falloff);
+            pixels[(dy + radius) * size + (dx + radius)] = (alpha << 24) | rgb;
+        }
+    }
+    
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_STATIC, size, size);
+    if (!texture) return nullptr;
+    
+    SDL_UpdateTexture(texture, nullptr, pixels.data(), size * sizeof(Uint32));
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+SDL_Texture* GlowCache::get(int radius, SDL_Color color) {
+    if (!renderer || radius <= 0 || radius > MAX_GLOW_RADIUS) return nullptr;
+    
+    Uint8 r = bucket(color.r), g = bucket(color.g), b = bucket(color.b);
+    Uint32 key = (Uint32(radius) << 24) | (Uint32(r) << 16) | (Uint32(g) << 8) | b;
+    
+    auto found = sprites.find(key);
+    if (found != sprites.end()) return found->second;
+    
+    SDL_Texture* texture = build(radius, r, g, b);
+    sprites[key] = texture;
+    return texture;
+}
+
+void GlowCache::draw(RenderBatch& batch, int x, int y, int radius, SDL_Color color, Uint8 alpha) {
+    SDL_Rect dest = {x - radius, y - radius, radius * 2 + 1, radius * 2 + 1};
+    draw(batch, dest, radius, color, alpha);
+}
+
+void GlowCache::draw(RenderBatch& batch, const SDL_Rect& dest, int radius, SDL_Color color, Uint8 alpha) {
+    SDL_Texture* texture = get(radius, color);
+    if (!texture) return;
+    
+    // Buckets round channels up, so modulation brings them back down to the
+    // requested colour (within one step)
+    SDL_Color modulation = {
+        static_cast<Uint8>(color.r * 255 / bucket(color.r)),
+        static_cast<Uint8>(color.g * 255 / bucket(color.g)),
+        static_cast<Uint8>(color.b * 255 / bucket(color.b)),
+        alpha
+    };
+    batch.copy(texture, nullptr, &dest, modulation);
+}
@@ -0,0 +1,38 @@
+#ifndef GLOW_CACHE_H
+#define GLOW_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <unordered_map>
+
+#include "render_batch.h"
+
+// Pre-rendered radial glow sprites, keyed by radius and a coarse colour
+// bucket. A glow is one textured quad on the frame's RenderBatch; the exact
+// colour and the per-frame alpha are applied as vertex colour modulation.
+class GlowCache {
+private:
+    SDL_Renderer* renderer;
+    std::unordered_map<Uint32, SDL_Texture*> sprites;
+    
+    static Uint8 bucket(Uint8 channel) { return channel | 0x07; }
+    SDL_Texture* build(int radius, Uint8 r, Uint8 g, Uint8 b);
+    
+public:
+    GlowCache();
+    ~GlowCache();
+    
+    void set_renderer(SDL_Renderer* target_renderer) { renderer = target_renderer; }
+    void clear();
+    
+    // Builds the sprite now if it is not cached yet
+    SDL_Texture* get(int radius, SDL_Color color);
+    
+    // Glow centred on (x, y) at its natural size
+    void draw(RenderBatch& batch, int x, int y, int radius, SDL_Color color, Uint8 alpha);
+    // Glow stretched over dest, for effects whose size animates
+    void draw(RenderBatch& batch, const SDL_Rect& dest, int radius, SDL_Color color, Uint8 alpha);
+    
+    size_t size() const { return sprites.size(); }
+};
+
+#endif // GLOW_CACHE_H
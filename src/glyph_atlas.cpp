@@ -0,0 +1,112 @@
+#include "glyph_atlas.h"
+
+// Atlas pages are square; a 16/24pt font fits its ASCII set in a fraction of one
+static const int ATLAS_PAGE_SIZE = 512;
+static const int GLYPH_PADDING = 1;
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font)
+    : renderer(renderer), font(font), shelf_x(0), shelf_y(0), shelf_height(0) {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    for (auto page : pages) {
+        SDL_DestroyTexture(page);
+    }
+}
+
+bool GlyphAtlas::add_page() {
+    SDL_Texture* page = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                          SDL_TEXTUREACCESS_STATIC,
+                                          ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+    if (!page) return false;
+    
+    SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+    pages.push_back(page);
+    shelf_x = 0;
+    shelf_y = 0;
+    shelf_height = 0;
+    return true;
+}
+
+void GlyphAtlas::warm_up() {
+    for (Uint16 c = 32; c < 127; c++) {
+        get_glyph(c);
+    }
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::get_glyph(Uint16 codepoint) {
+    auto found = glyphs.find(codepoint);
+    if (found != glyphs.end()) return &found->second;
+    
+    Glyph glyph = {-1, {0, 0, 0, 0}, 0, 0};
+    int min_x = 0, max_x = 0, min_y = 0, max_y = 0, advance = 0;
+    if (TTF_GlyphMetrics(font, codepoint, &min_x, &max_x, &min_y, &max_y, &advance) == 0) {
+        glyph.advance = advance;
+        glyph.offset_x = min_x < 0 ? min_x : 0;
+    }
+    
+    // Rendered in white; the draw colour is applied per vertex
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* rendered = TTF_RenderGlyph_Blended(font, codepoint, white);
+    SDL_Surface* surface = rendered ? SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+    if (rendered) SDL_FreeSurface(rendered);
+    
+    if (surface && surface->w > 0 && surface->h > 0 &&
+        surface->w <= ATLAS_PAGE_SIZE && surface->h <= ATLAS_PAGE_SIZE) {
+        // Next shelf when this row is full, next page when the page is full
+        if (!pages.empty() && shelf_x + surface->w > ATLAS_PAGE_SIZE) {
+            shelf_x = 0;
+            shelf_y += shelf_height + GLYPH_PADDING;
+            shelf_height = 0;
+        }
+        bool has_room = !pages.empty() && shelf_y + surface->h <= ATLAS_PAGE_SIZE;
+        if (has_room || add_page()) {
+            SDL_Rect dest = {shelf_x, shelf_y, surface->w, surface->h};
+            if (SDL_UpdateTexture(pages.back(), &dest, surface->pixels, surface->pitch) == 0) {
+                glyph.page = static_cast<int>(pages.size()) - 1;
+                glyph.src = dest;
+            }
+            shelf_x += surface->w + GLYPH_PADDING;
+            if (surface->h > shelf_height) shelf_height = surface->h;
+        }
+        if (glyph.advance == 0) glyph.advance = surface->w;
+    }
+    if (surface) SDL_FreeSurface(surface);
+    
+    return &(glyphs[codepoint] = glyph);
+}
+
+// Decodes one UTF-8 sequence; malformed bytes come out as '?'
+static Uint32 next_codepoint(const std::string& text, size_t& i) {
+    unsigned char lead = static_cast<unsigned char>(text[i++]);
+    if (lead < 0x80) return lead;
+    
+    int extra = (lead >= 0xF0) ? 3 : (lead >= 0xE0) ? 2 : (lead >= 0xC0) ? 1 : -1;
+    if (extra < 0) return '?';
+    
+    Uint32 codepoint = lead & (0x3F >> extra);
+    for (int k = 0; k < extra; k++) {
+        if (i >= text.size() || (static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) return '?';
+        codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[i++]) & 0x3F);
+    }
+    return codepoint;
+}
+
+int GlyphAtlas::draw(RenderBatch& batch, const std::string& text, int x, int y, SDL_Color color) {
+    if (text.empty() || color.a == 0) return 0;
+    
+    int pen_x = x;
+    size_t i = 0;
+    while (i < text.size()) {
+        Uint32 codepoint = next_codepoint(text, i);
+        if (codepoint > 0xFFFF) codepoint = '?';
+        
+        const Glyph* glyph = get_glyph(static_cast<Uint16>(codepoint));
+        if (glyph->page >= 0) {
+            SDL_Rect dest = {pen_x + glyph->offset_x, y, glyph->src.w, glyph->src.h};
+            batch.copy(pages[glyph->page], &glyph->src, &dest, color);
+        }
+        pen_x += glyph->advance;
+    }
+    return pen_x - x;
+}
@@ -0,0 +1,49 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "render_batch.h"
+
+// Glyph cache for one TTF_Font. Each glyph is rendered once, in white, into
+// a shared atlas texture; a string is then queued as textured quads on the
+// frame's RenderBatch with the text colour carried by the vertices, so drawing
+// text never creates a texture once its glyphs have been seen.
+class GlyphAtlas {
+private:
+    struct Glyph {
+        int page;
+        SDL_Rect src;      // Location in the atlas page
+        int offset_x;      // Surface origin relative to the pen position
+        int advance;
+    };
+    
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    std::vector<SDL_Texture*> pages;
+    std::unordered_map<Uint16, Glyph> glyphs;
+    
+    // Shelf packer state for the newest page
+    int shelf_x, shelf_y, shelf_height;
+    
+    bool add_page();
+    const Glyph* get_glyph(Uint16 codepoint);
+
+public:
+    GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font);
+    ~GlyphAtlas();
+    
+    // Renders printable ASCII up front so the usual HUD text costs no uploads
+    void warm_up();
+    
+    // Draws UTF-8 text with its top-left corner at (x, y); returns the advance
+    int draw(RenderBatch& batch, const std::string& text, int x, int y, SDL_Color color);
+    
+    TTF_Font* get_font() const { return font; }
+};
+
+#endif // GLYPH_ATLAS_H
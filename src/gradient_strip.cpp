@@ -0,0 +1,47 @@
+#include "gradient_strip.h"
+
+GradientStrip::GradientStrip() : renderer(nullptr), texture(nullptr) {
+}
+
+GradientStrip::~GradientStrip() {
+    destroy();
+}
+
+bool GradientStrip::create(SDL_Renderer* target_renderer, int height) {
+    destroy();
+    renderer = target_renderer;
+    rows.assign(height, 0xFF000000u);
+    
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                SDL_TEXTUREACCESS_STREAMING, 1, height);
+    return texture != nullptr;
+}
+
+void GradientStrip::destroy() {
+    if (texture) SDL_DestroyTexture(texture);
+    texture = nullptr;
+}
+
+int GradientStrip::draw(RenderBatch& batch, int width) {
+    int height = get_height();
+    
+    // A quad still queued from an earlier draw must go out before the
+    // column is overwritten
+    batch.flush();
+    
+    if (texture && SDL_UpdateTexture(texture, nullptr, rows.data(), sizeof(Uint32)) == 0) {
+        SDL_Rect dest = {0, 0, width, height};
+        SDL_Color white = {255, 255, 255, 255};
+        batch.copy(texture, nullptr, &dest, white);
+        return 1;
+    }
+    
+    // No streaming texture: fall back to one rect per scanline
+    for (int y = 0; y < height; y++) {
+        Uint32 c = rows[y];
+        batch.set_draw_color((c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF, 255);
+        SDL_Rect line = {0, y, width, 1};
+        batch.fill_rect(&line);
+    }
+    return height;
+}
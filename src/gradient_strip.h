@@ -0,0 +1,35 @@
+#ifndef GRADIENT_STRIP_H
+#define GRADIENT_STRIP_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "render_batch.h"
+
+// Full-screen vertical gradient kept as a 1-pixel-wide streaming texture.
+// Callers fill one colour per scanline, then draw() uploads the column and
+// queues it stretched across the target as a single quad, so the result
+// matches the old one-rect-per-line backgrounds pixel for pixel.
+class GradientStrip {
+private:
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    std::vector<Uint32> rows;  // ARGB8888, one per scanline
+    
+public:
+    GradientStrip();
+    ~GradientStrip();
+    
+    bool create(SDL_Renderer* target_renderer, int height);
+    void destroy();
+    
+    int get_height() const { return static_cast<int>(rows.size()); }
+    void set_row(int y, Uint8 r, Uint8 g, Uint8 b) {
+        rows[y] = 0xFF000000u | (Uint32(r) << 16) | (Uint32(g) << 8) | b;
+    }
+    
+    // Returns the number of draws queued
+    int draw(RenderBatch& batch, int width);
+};
+
+#endif // GRADIENT_STRIP_H
@@ -0,0 +1,43 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Fixed-capacity particle pool stored as separate arrays (structure of
+// arrays). The update loop streams over plain float arrays so the compiler
+// can vectorize it, and dead particles are removed by swapping in the last
+// live one, so a frame costs O(n) however many particles die.
+class ParticlePool {
+private:
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> life;
+    std::vector<float> inv_max_life;
+    std::vector<Uint32> color;  // Packed 0xRRGGBB; alpha follows remaining life
+    size_t count;
+    size_t max_count;
+    size_t padded_capacity;
+    
+    void integrate(float dt);
+    void remove_dead();
+    
+public:
+    explicit ParticlePool(size_t capacity = 0);
+    
+    // Drops every particle
+    void set_capacity(size_t capacity);
+    size_t get_capacity() const { return max_count; }
+    
+    bool add(float px, float py, float pvx, float pvy, float lifetime, SDL_Color rgb);
+    void update(float dt);
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    bool full() const { return count == max_count; }
+    
+    float get_x(size_t index) const { return x[index]; }
+    float get_y(size_t index) const { return y[index]; }
+    SDL_Color get_color(size_t index) const;
+};
+
+#endif // PARTICLES_H
@@ -0,0 +1,62 @@
+#include "quad_mesh.h"
+
+void QuadMesh::reserve_quads(size_t quads) {
+    vertices.reserve(quads * 4);
+    indices.reserve(quads * 6);
+}
+
+void QuadMesh::add_quad(const SDL_Vertex corners[4]) {
+    int base = static_cast<int>(vertices.size());
+    vertices.insert(vertices.end(), corners, corners + 4);
+    
+    int quad_indices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+    indices.insert(indices.end(), quad_indices, quad_indices + 6);
+}
+
+void QuadMesh::add_rect(float x0, float y0, float x1, float y1,
+                        float u0, float v0, float u1, float v1, SDL_Color color) {
+    SDL_Vertex corners[4] = {
+        {{x0, y0}, color, {u0, v0}},
+        {{x1, y0}, color, {u1, v0}},
+        {{x1, y1}, color, {u1, v1}},
+        {{x0, y1}, color, {u0, v1}}
+    };
+    add_quad(corners);
+}
+
+void QuadMesh::add_rect(const SDL_Rect& rect, SDL_Color color) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    add_rect(static_cast<float>(rect.x), static_cast<float>(rect.y),
+             static_cast<float>(rect.x + rect.w), static_cast<float>(rect.y + rect.h),
+             0, 0, 0, 0, color);
+}
+
+void QuadMesh::add_outline(const SDL_Rect& rect, SDL_Color color) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    
+    // Four edges that do not overlap at the corners
+    SDL_Rect top = {rect.x, rect.y, rect.w, 1};
+    SDL_Rect bottom = {rect.x, rect.y + rect.h - 1, rect.w, 1};
+    SDL_Rect left = {rect.x, rect.y + 1, 1, rect.h - 2};
+    SDL_Rect right = {rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2};
+    
+    add_rect(top, color);
+    if (rect.h > 1) add_rect(bottom, color);
+    add_rect(left, color);
+    if (rect.w > 1) add_rect(right, color);
+}
+
+void QuadMesh::append(const QuadMesh& other) {
+    int base = static_cast<int>(vertices.size());
+    vertices.insert(vertices.end(), other.vertices.begin(), other.vertices.end());
+    for (int index : other.indices) {
+        indices.push_back(base + index);
+    }
+}
+
+void QuadMesh::translate(float dx, float dy) {
+    for (auto& vertex : vertices) {
+        vertex.position.x += dx;
+        vertex.position.y += dy;
+    }
+}
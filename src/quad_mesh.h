@@ -0,0 +1,36 @@
+#ifndef QUAD_MESH_H
+#define QUAD_MESH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Growable vertex/index buffer of quads for SDL_RenderGeometry. clear()
+// keeps the capacity, so a mesh rebuilt every frame stops allocating once
+// it has reached its largest size.
+class QuadMesh {
+private:
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    
+public:
+    void reserve_quads(size_t quads);
+    void clear() { vertices.clear(); indices.clear(); }
+    bool empty() const { return indices.empty(); }
+    
+    // Corners in order around the quad
+    void add_quad(const SDL_Vertex corners[4]);
+    void add_rect(float x0, float y0, float x1, float y1,
+                  float u0, float v0, float u1, float v1, SDL_Color color);
+    void add_rect(const SDL_Rect& rect, SDL_Color color);
+    // One-pixel outline matching SDL_RenderDrawRect
+    void add_outline(const SDL_Rect& rect, SDL_Color color);
+    void append(const QuadMesh& other);
+    void translate(float dx, float dy);
+    
+    const SDL_Vertex* get_vertices() const { return vertices.data(); }
+    int get_vertex_count() const { return static_cast<int>(vertices.size()); }
+    const int* get_indices() const { return indices.data(); }
+    int get_index_count() const { return static_cast<int>(indices.size()); }
+};
+
+#endif // QUAD_MESH_H
@@ -0,0 +1,180 @@
+#include "render_batch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+RenderBatch::RenderBatch()
+    : renderer(nullptr), batch_texture(nullptr), batch_blend_mode(SDL_BLENDMODE_NONE),
+      texture_width(1.0f), texture_height(1.0f), batch_origin_x(0), batch_origin_y(0),
+      draw_blend_mode(SDL_BLENDMODE_NONE), origin_x(0), origin_y(0),
+      override_blend(false), override_blend_mode(SDL_BLENDMODE_BLEND),
+      submitted_draws(0), draw_calls(0) {
+    SDL_Color white = {255, 255, 255, 255};
+    draw_color = white;
+}
+
+void RenderBatch::set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    SDL_Color color = {r, g, b, a};
+    draw_color = color;
+}
+
+void RenderBatch::set_blend_mode(SDL_BlendMode blend_mode) {
+    draw_blend_mode = blend_mode;
+}
+
+void RenderBatch::set_blend_override(SDL_BlendMode blend_mode) {
+    flush();
+    override_blend = true;
+    override_blend_mode = blend_mode;
+}
+
+void RenderBatch::clear_blend_override() {
+    flush();
+    override_blend = false;
+}
+
+void RenderBatch::use_state(SDL_Texture* texture, SDL_BlendMode blend_mode) {
+    if (override_blend) blend_mode = override_blend_mode;
+    if (texture == batch_texture && blend_mode == batch_blend_mode &&
+        origin_x == batch_origin_x && origin_y == batch_origin_y) return;
+    
+    flush();
+    batch_texture = texture;
+    batch_blend_mode = blend_mode;
+    batch_origin_x = origin_x;
+    batch_origin_y = origin_y;
+    
+    texture_width = texture_height = 1.0f;
+    if (texture) {
+        int w = 1, h = 1;
+        SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+        texture_width = static_cast<float>(std::max(w, 1));
+        texture_height = static_cast<float>(std::max(h, 1));
+    }
+}
+
+void RenderBatch::fill_rect(const SDL_Rect* rect) {
+    if (!rect || rect->w <= 0 || rect->h <= 0) return;
+    
+    use_state(nullptr, draw_blend_mode);
+    pending.add_rect(*rect, draw_color);
+    submitted_draws++;
+}
+
+void RenderBatch::draw_rect(const SDL_Rect* rect) {
+    if (!rect || rect->w <= 0 || rect->h <= 0) return;
+    
+    use_state(nullptr, draw_blend_mode);
+    pending.add_outline(*rect, draw_color);
+    submitted_draws++;
+}
+
+void RenderBatch::draw_point(int x, int y) {
+    use_state(nullptr, draw_blend_mode);
+    SDL_Rect point = {x, y, 1, 1};
+    pending.add_rect(point, draw_color);
+    submitted_draws++;
+}
+
+void RenderBatch::draw_line(int x1, int y1, int x2, int y2) {
+    use_state(nullptr, draw_blend_mode);
+    if (x1 == x2 || y1 == y2) {
+        // Axis-aligned: a one-pixel-wide rect covering both end points
+        SDL_Rect line = {std::min(x1, x2), std::min(y1, y2),
+                         std::abs(x2 - x1) + 1, std::abs(y2 - y1) + 1};
+        pending.add_rect(line, draw_color);
+    } else {
+        // Diagonal: a one-pixel-thick quad along the pixel centres
+        float ax = x1 + 0.5f, ay = y1 + 0.5f, bx = x2 + 0.5f, by = y2 + 0.5f;
+        float length = sqrtf((bx - ax) * (bx - ax) + (by - ay) * (by - ay));
+        float nx = -(by - ay) / length * 0.5f, ny = (bx - ax) / length * 0.5f;
+        
+        SDL_Vertex quad[4] = {
+            {{ax + nx, ay + ny}, draw_color, {0, 0}},
+            {{bx + nx, by + ny}, draw_color, {0, 0}},
+            {{bx - nx, by - ny}, draw_color, {0, 0}},
+            {{ax - nx, ay - ny}, draw_color, {0, 0}}
+        };
+        pending.add_quad(quad);
+    }
+    submitted_draws++;
+}
+
+void RenderBatch::copy(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dest, SDL_Color color) {
+    if (!texture) return;
+    
+    SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+    SDL_GetTextureBlendMode(texture, &blend_mode);
+    use_state(texture, blend_mode);
+    
+    float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+    if (src) {
+        u0 = src->x / texture_width;
+        v0 = src->y / texture_height;
+        u1 = (src->x + src->w) / texture_width;
+        v1 = (src->y + src->h) / texture_height;
+    }
+    
+    float x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    if (dest) {
+        x0 = static_cast<float>(dest->x);
+        y0 = static_cast<float>(dest->y);
+        x1 = static_cast<float>(dest->x + dest->w);
+        y1 = static_cast<float>(dest->y + dest->h);
+    } else {
+        int w = 0, h = 0;
+        SDL_GetRendererOutputSize(renderer, &w, &h);
+        x1 = static_cast<float>(w);
+        y1 = static_cast<float>(h);
+    }
+    
+    pending.add_rect(x0, y0, x1, y1, u0, v0, u1, v1, color);
+    submitted_draws++;
+}
+
+void RenderBatch::draw_mesh(const QuadMesh& mesh) {
+    if (mesh.empty()) return;
+    
+    use_state(nullptr, draw_blend_mode);
+    submitted_draws++;
+    
+    // Merge with quads already queued in the same state, or translate a copy
+    // when an origin is set; otherwise the mesh goes straight to SDL
+    if (origin_x != 0 || origin_y != 0 || !pending.empty()) {
+        pending.append(mesh);
+        flush();
+        return;
+    }
+    
+    SDL_SetRenderDrawBlendMode(renderer, batch_blend_mode);
+    SDL_RenderGeometry(renderer, nullptr, mesh.get_vertices(), mesh.get_vertex_count(),
+                       mesh.get_indices(), mesh.get_index_count());
+    draw_calls++;
+}
+
+void RenderBatch::flush() {
+    if (pending.empty()) return;
+    
+    if (batch_origin_x != 0 || batch_origin_y != 0) {
+        pending.translate(static_cast<float>(batch_origin_x), static_cast<float>(batch_origin_y));
+    }
+    
+    // Untextured geometry blends with the renderer's draw blend mode; a
+    // texture's own mode is swapped only for the duration of an override
+    SDL_BlendMode texture_blend_mode = SDL_BLENDMODE_BLEND;
+    if (!batch_texture) {
+        SDL_SetRenderDrawBlendMode(renderer, batch_blend_mode);
+    } else if (override_blend) {
+        SDL_GetTextureBlendMode(batch_texture, &texture_blend_mode);
+        SDL_SetTextureBlendMode(batch_texture, batch_blend_mode);
+    }
+    
+    SDL_RenderGeometry(renderer, batch_texture, pending.get_vertices(), pending.get_vertex_count(),
+                       pending.get_indices(), pending.get_index_count());
+    draw_calls++;
+    
+    if (batch_texture && override_blend) {
+        SDL_SetTextureBlendMode(batch_texture, texture_blend_mode);
+    }
+    pending.clear();
+}
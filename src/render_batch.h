@@ -0,0 +1,77 @@
+#ifndef RENDER_BATCH_H
+#define RENDER_BATCH_H
+
+#include <SDL2/SDL.h>
+#include "quad_mesh.h"
+
+// Frame-local command buffer in front of the SDL renderer. It mirrors the
+// SDL draw calls the game uses (colour, blend mode, rects, points, lines,
+// texture copies) but turns each one into quads in a shared vertex buffer.
+// Consecutive commands that share a texture and blend mode go out in a
+// single SDL_RenderGeometry call. Submission order is kept, because later
+// draws are meant to cover earlier ones.
+class RenderBatch {
+private:
+    SDL_Renderer* renderer;
+    QuadMesh pending;
+    
+    // State of the pending batch
+    SDL_Texture* batch_texture;
+    SDL_BlendMode batch_blend_mode;
+    float texture_width, texture_height;
+    int batch_origin_x, batch_origin_y;
+    
+    // Current draw state, as set by the callers
+    SDL_Color draw_color;
+    SDL_BlendMode draw_blend_mode;
+    int origin_x, origin_y;
+    bool override_blend;
+    SDL_BlendMode override_blend_mode;
+    
+    int submitted_draws;
+    int draw_calls;
+    
+    void use_state(SDL_Texture* texture, SDL_BlendMode blend_mode);
+    
+public:
+    RenderBatch();
+    
+    void set_renderer(SDL_Renderer* target_renderer) { renderer = target_renderer; }
+    SDL_Renderer* get_renderer() const { return renderer; }
+    
+    // Same meaning as SDL_SetRenderDrawColor / SDL_SetRenderDrawBlendMode
+    void set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+    void set_blend_mode(SDL_BlendMode blend_mode);
+    
+    // Offset added to everything drawn from now on (screen shake)
+    void set_origin(int x, int y) { origin_x = x; origin_y = y; }
+    int get_origin_x() const { return origin_x; }
+    int get_origin_y() const { return origin_y; }
+    
+    // Forces one blend mode on every draw, textured or not, until cleared;
+    // used while drawing into a RenderLayer
+    void set_blend_override(SDL_BlendMode blend_mode);
+    void clear_blend_override();
+    
+    void fill_rect(const SDL_Rect* rect);
+    void draw_rect(const SDL_Rect* rect);
+    void draw_point(int x, int y);
+    void draw_line(int x1, int y1, int x2, int y2);
+    
+    // Textured quad; colour multiplies the texture like colour/alpha mod
+    void copy(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dest, SDL_Color color);
+    
+    // Prebuilt untextured mesh in the current blend mode, drawn in one call
+    void draw_mesh(const QuadMesh& mesh);
+    
+    // Sends everything queued so far; call before presenting or before any
+    // draw that bypasses the batch
+    void flush();
+    
+    // Per-frame counters: draws submitted vs SDL calls actually issued
+    int get_submitted_draws() const { return submitted_draws; }
+    int get_draw_calls() const { return draw_calls; }
+    void reset_stats() { submitted_draws = 0; draw_calls = 0; }
+};
+
+#endif // RENDER_BATCH_H
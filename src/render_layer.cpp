@@ -0,0 +1,90 @@
+#include "render_layer.h"
+
+// Drawing into the layer: colour blends as usual, alpha accumulates, which
+// leaves premultiplied colour in the texture
+static SDL_BlendMode layer_draw_blend_mode() {
+    return SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                                      SDL_BLENDOPERATION_ADD,
+                                      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                                      SDL_BLENDOPERATION_ADD);
+}
+
+// Compositing premultiplied contents over the screen
+static SDL_BlendMode layer_composite_blend_mode() {
+    return SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                                      SDL_BLENDOPERATION_ADD,
+                                      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                                      SDL_BLENDOPERATION_ADD);
+}
+
+RenderLayer::RenderLayer()
+    : renderer(nullptr), texture(nullptr), dirty(true), drawing(false),
+      saved_origin_x(0), saved_origin_y(0) {
+    area.x = area.y = area.w = area.h = 0;
+}
+
+RenderLayer::~RenderLayer() {
+    destroy();
+}
+
+bool RenderLayer::create(SDL_Renderer* target_renderer, const SDL_Rect& layer_area) {
+    destroy();
+    renderer = target_renderer;
+    area = layer_area;
+    dirty = true;
+    
+    if (!SDL_RenderTargetSupported(renderer)) return false;
+    
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                area.w, area.h);
+    if (!texture) return false;
+    
+    // The software renderer has no custom blend modes
+    if (SDL_SetTextureBlendMode(texture, layer_composite_blend_mode()) != 0) {
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+void RenderLayer::destroy() {
+    if (texture) SDL_DestroyTexture(texture);
+    texture = nullptr;
+}
+
+bool RenderLayer::begin(RenderBatch& batch) {
+    if (!texture) return true;
+    if (!dirty) return false;
+    
+    batch.flush();
+    if (SDL_SetRenderTarget(renderer, texture) != 0) return true;
+    
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    
+    // Callers draw in screen coordinates
+    saved_origin_x = batch.get_origin_x();
+    saved_origin_y = batch.get_origin_y();
+    batch.set_origin(-area.x, -area.y);
+    batch.set_blend_override(layer_draw_blend_mode());
+    drawing = true;
+    return true;
+}
+
+void RenderLayer::end(RenderBatch& batch) {
+    if (!drawing) return;
+    
+    batch.clear_blend_override();
+    batch.set_origin(saved_origin_x, saved_origin_y);
+    SDL_SetRenderTarget(renderer, nullptr);
+    drawing = false;
+    dirty = false;
+}
+
+void RenderLayer::composite(RenderBatch& batch, int offset_x, int offset_y) {
+    if (!texture || dirty) return;
+    
+    SDL_Rect dest = {area.x + offset_x, area.y + offset_y, area.w, area.h};
+    SDL_Color white = {255, 255, 255, 255};
+    batch.copy(texture, nullptr, &dest, white);
+}
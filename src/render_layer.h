@@ -0,0 +1,44 @@
+#ifndef RENDER_LAYER_H
+#define RENDER_LAYER_H
+
+#include <SDL2/SDL.h>
+
+#include "render_batch.h"
+
+// Cached off-screen layer for content that only changes on state changes.
+// While dirty, begin() redirects the batch into a render-target texture and
+// the caller redraws the layer; otherwise it is composited with a single
+// copy. Contents are stored with premultiplied alpha so translucent text
+// and fills composite exactly as if drawn straight to the screen.
+//
+// Renderers without target textures or custom blend modes make begin()
+// always return true and draw straight to the screen instead.
+class RenderLayer {
+private:
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    SDL_Rect area;
+    bool dirty;
+    bool drawing;
+    int saved_origin_x, saved_origin_y;  // Batch origin to restore in end()
+    
+public:
+    RenderLayer();
+    ~RenderLayer();
+    
+    // Layer covering area of the screen; false means the fallback is in use
+    bool create(SDL_Renderer* target_renderer, const SDL_Rect& layer_area);
+    void destroy();
+    
+    void mark_dirty() { dirty = true; }
+    bool is_dirty() const { return dirty; }
+    
+    // True when the caller has to draw the layer contents now
+    bool begin(RenderBatch& batch);
+    void end(RenderBatch& batch);
+    
+    // Draws the cached contents shifted by (offset_x, offset_y)
+    void composite(RenderBatch& batch, int offset_x = 0, int offset_y = 0);
+};
+
+#endif // RENDER_LAYER_H
@@ -0,0 +1,226 @@
+#include "save_writer.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <iostream>
+#include <utility>
+
+// Wait after the first write of a batch so the game-over saves, which
+// arrive a few calls apart, go out together
+static const Uint32 SAVE_COALESCE_MS = 50;
+
+SaveWriter::SaveWriter()
+    : thread(nullptr), mutex(nullptr), wake(nullptr), idle(nullptr),
+      quit(false), writing(false) {
+}
+
+SaveWriter::~SaveWriter() {
+    stop();
+}
+
+bool SaveWriter::start() {
+    if (thread) return true;
+    
+    mutex = SDL_CreateMutex();
+    wake = SDL_CreateCond();
+    idle = SDL_CreateCond();
+    quit = false;
+    if (mutex && wake && idle) {
+        thread = SDL_CreateThread(thread_main, "save_writer", this);
+    }
+    if (!thread) {
+        std::cerr << "Warning: Save writer thread unavailable, saving synchronously: " << SDL_GetError() << std::endl;
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void SaveWriter::stop() {
+    if (thread) {
+        SDL_LockMutex(mutex);
+        quit = true;
+        SDL_CondSignal(wake);
+        SDL_UnlockMutex(mutex);
+        SDL_WaitThread(thread, nullptr);
+        thread = nullptr;
+    }
+    
+    // Nothing is lost if the thread never ran
+    if (!pending.empty()) {
+        write_batch(pending);
+        pending = SaveBatch();
+    }
+    
+    if (idle) SDL_DestroyCond(idle);
+    if (wake) SDL_DestroyCond(wake);
+    if (mutex) SDL_DestroyMutex(mutex);
+    idle = wake = nullptr;
+    mutex = nullptr;
+}
+
+void SaveWriter::write(const std::string& path, const std::string& contents) {
+    if (!thread) {
+        write_file(path, contents);
+        return;
+    }
+    
+    SDL_LockMutex(mutex);
+    pending.files[path] = contents;
+    pending.appends.erase(path);    // Replaced along with the rest of the file
+    SDL_CondSignal(wake);
+    SDL_UnlockMutex(mutex);
+}
+
+void SaveWriter::append(const std::string& path, const std::string& bytes) {
+    if (!thread) {
+        append_file(path, bytes);
+        return;
+    }
+    
+    SDL_LockMutex(mutex);
+    // Appends run before replacements, so bytes for a file still queued
+    // for replacement go on the end of its new contents instead
+    std::map<std::string, std::string>::iterator file = pending.files.find(path);
+    if (file != pending.files.end()) {
+        file->second += bytes;
+    } else {
+        pending.appends[path] += bytes;
+    }
+    SDL_CondSignal(wake);
+    SDL_UnlockMutex(mutex);
+}
+
+void SaveWriter::flush() {
+    if (!thread) return;
+    
+    SDL_LockMutex(mutex);
+    while (!pending.empty() || writing) {
+        SDL_CondSignal(wake);
+        SDL_CondWait(idle, mutex);
+    }
+    SDL_UnlockMutex(mutex);
+}
+
+int SaveWriter::thread_main(void* data) {
+    static_cast<SaveWriter*>(data)->run();
+    return 0;
+}
+
+void SaveWriter::run() {
+    SDL_LockMutex(mutex);
+    while (true) {
+        while (pending.empty() && !quit) {
+            SDL_CondWait(wake, mutex);
+        }
+        if (pending.empty()) break;
+        
+        Uint32 deadline = SDL_GetTicks() + SAVE_COALESCE_MS;
+        while (!quit && static_cast<Sint32>(deadline - SDL_GetTicks()) > 0) {
+            SDL_CondWaitTimeout(wake, mutex, deadline - SDL_GetTicks());
+        }
+        
+        SaveBatch batch;
+        std::swap(batch, pending);
+        writing = true;
+        SDL_UnlockMutex(mutex);
+        
+        write_batch(batch);
+        
+        SDL_LockMutex(mutex);
+        writing = false;
+        SDL_CondBroadcast(idle);
+    }
+    SDL_CondBroadcast(idle);
+    SDL_UnlockMutex(mutex);
+}
+
+static std::string get_temp_path(const std::string& path) {
+    return path + ".tmp";
+}
+
+static std::string get_directory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    if (slash == std::string::npos) return ".";
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+static bool write_all(int fd, const std::string& bytes) {
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t result = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (result <= 0) return false;
+        written += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+// Contents to path.tmp and fsynced; false leaves the old file untouched
+static bool write_temp_file(const std::string& path, const std::string& contents) {
+    std::string temp_path = get_temp_path(path);
+    int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    
+    bool ok = write_all(fd, contents) && fsync(fd) == 0;
+    if (close(fd) != 0) ok = false;
+    
+    if (!ok) unlink(temp_path.c_str());
+    return ok;
+}
+
+// Makes the renames themselves durable
+static void sync_directory(const std::string& directory) {
+    int fd = open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+
+// Bytes at the end of path, fsynced
+static bool append_bytes(const std::string& path, const std::string& bytes) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return false;
+    
+    bool ok = write_all(fd, bytes) && fsync(fd) == 0;
+    if (close(fd) != 0) ok = false;
+    return ok;
+}
+
+bool SaveWriter::write_batch(const SaveBatch& batch) {
+    bool all_written = true;
+    std::map<std::string, bool> directories;
+    for (const auto& journal : batch.appends) {
+        if (!append_bytes(journal.first, journal.second)) {
+            std::cerr << "Warning: Could not append to " << journal.first << std::endl;
+            all_written = false;
+            continue;
+        }
+        directories[get_directory(journal.first)] = true;  // The file may be new
+    }
+    for (const auto& file : batch.files) {
+        if (!write_temp_file(file.first, file.second) ||
+            rename(get_temp_path(file.first).c_str(), file.first.c_str()) != 0) {
+            std::cerr << "Warning: Could not save " << file.first << std::endl;
+            unlink(get_temp_path(file.first).c_str());
+            all_written = false;
+            continue;
+        }
+        directories[get_directory(file.first)] = true;
+    }
+    for (const auto& directory : directories) {
+        sync_directory(directory.first);
+    }
+    return all_written;
+}
+
+bool SaveWriter::write_file(const std::string& path, const std::string& contents) {
+    SaveBatch batch;
+    batch.files[path] = contents;
+    return write_batch(batch);
+}
+
+bool SaveWriter::append_file(const std::string& path, const std::string& bytes) {
+    SaveBatch batch;
+    batch.appends[path] = bytes;
+    return write_batch(batch);
+}
@@ -0,0 +1,63 @@
+#ifndef SAVE_WRITER_H
+#define SAVE_WRITER_H
+
+#include <SDL2/SDL.h>
+#include <map>
+#include <string>
+
+// Writes the save files (high score, stats, achievements) on an I/O thread
+// so a slow disk never stalls a frame. write() only stores the new contents;
+// several writes to the same file before the thread gets to it collapse into
+// one. Each file is replaced atomically: the contents go to a temp file that
+// is fsynced and renamed over the old one, and a batch of files costs a
+// single directory fsync. Appends to journals are written and fsynced
+// before any replacement in the same batch, so a snapshot never lands
+// ahead of the records it covers.
+struct SaveBatch {
+    std::map<std::string, std::string> files;    // Path to its newest contents
+    std::map<std::string, std::string> appends;  // Path to bytes to add, in order
+    
+    bool empty() const { return files.empty() && appends.empty(); }
+};
+
+class SaveWriter {
+private:
+    SDL_Thread* thread;
+    SDL_mutex* mutex;
+    SDL_cond* wake;
+    SDL_cond* idle;
+    bool quit;
+    bool writing;                              // A batch is being written
+    SaveBatch pending;
+    
+    static int thread_main(void* data);
+    void run();
+    static bool write_batch(const SaveBatch& batch);
+    
+public:
+    SaveWriter();
+    ~SaveWriter();
+    
+    bool start();
+    
+    // Writes everything still queued, then ends the thread
+    void stop();
+    
+    // Queues contents for path; written synchronously when not started
+    void write(const std::string& path, const std::string& contents);
+    
+    // Queues bytes for the end of path, created if missing. Lands after
+    // any write() to the same path queued before it.
+    void append(const std::string& path, const std::string& bytes);
+    
+    // Blocks until every queued write is on disk
+    void flush();
+    
+    // Temp file, fsync and rename in the calling thread
+    static bool write_file(const std::string& path, const std::string& contents);
+    
+    // Append and fsync in the calling thread
+    static bool append_file(const std::string& path, const std::string& bytes);
+};
+
+#endif // SAVE_WRITER_H
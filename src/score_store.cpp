@@ -0,0 +1,343 @@
+#include "score_store.h"
+#include "save_writer.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char SCORE_MAGIC[8] = {'S', 'N', 'K', 'S', 'C', 'R', '1', '\0'};
+static const size_t SCORE_HEADER_SIZE = 16;
+
+static_assert(sizeof(ScoreRecord) == 32, "scores.db records are 32 bytes");
+
+static bool is_valid_difficulty(int difficulty) {
+    return difficulty > 0 && difficulty < SCORE_DIFFICULTY_SLOTS;
+}
+
+// Higher score first; ties go to the earlier run
+static bool is_better_run(const ScoreRecord& a, const ScoreRecord& b) {
+    if (a.score != b.score) return a.score > b.score;
+    return a.timestamp < b.timestamp;
+}
+
+void ScoreStore::RankTree::resize(uint32_t max_score) {
+    uint32_t size = 1024;
+    while (size <= max_score && size < SCORE_RANK_LIMIT) size *= 2;
+    counts.assign(size + 1, 0);
+    total = 0;
+}
+
+void ScoreStore::RankTree::add(uint32_t score) {
+    uint32_t size = static_cast<uint32_t>(counts.size()) - 1;
+    for (uint32_t i = std::min(score, size - 1) + 1; i <= size; i += i & (~i + 1)) {
+        counts[i]++;
+    }
+    total++;
+}
+
+void ScoreStore::RankTree::remove(uint32_t score) {
+    uint32_t size = static_cast<uint32_t>(counts.size()) - 1;
+    for (uint32_t i = std::min(score, size - 1) + 1; i <= size; i += i & (~i + 1)) {
+        counts[i]--;
+    }
+    total--;
+}
+
+void ScoreStore::RankTree::clear_to_size_of(const RankTree& other) {
+    counts.assign(other.counts.size(), 0);
+    total = 0;
+}
+
+uint32_t ScoreStore::RankTree::count_above(uint32_t score) const {
+    if (counts.empty()) return 0;
+    
+    // Runs scoring at most score, then the rest
+    uint32_t size = static_cast<uint32_t>(counts.size()) - 1;
+    uint32_t at_most = 0;
+    for (uint32_t i = std::min(score, size - 1) + 1; i > 0; i -= i & (~i + 1)) {
+        at_most += counts[i];
+    }
+    return total - at_most;
+}
+
+ScoreStore::ScoreStore()
+    : mapped(nullptr), mapped_count(0), mapping(nullptr), mapping_size(0),
+      has_header(false), writer(nullptr) {
+}
+
+ScoreStore::~ScoreStore() {
+    close();
+}
+
+bool ScoreStore::open(const std::string& store_path) {
+    close();
+    path = store_path;
+    
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= SCORE_HEADER_SIZE) {
+            void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                mapping = data;
+                mapping_size = info.st_size;
+            }
+        }
+        ::close(fd);
+    }
+    
+    if (mapping) {
+        const char* bytes = static_cast<const char*>(mapping);
+        uint32_t version = 0, record_size = 0;
+        memcpy(&version, bytes + 8, 4);
+        memcpy(&record_size, bytes + 12, 4);
+        if (memcmp(bytes, SCORE_MAGIC, sizeof(SCORE_MAGIC)) != 0 || version != SCORE_STORE_VERSION ||
+            record_size != sizeof(ScoreRecord)) {
+            std::cerr << "Warning: " << path << " is from another version, keeping it untouched" << std::endl;
+            close();
+            path.clear();  // Nothing gets appended to it
+            return false;
+        }
+        
+        // A run cut off mid-write is ignored and later overwritten
+        mapped = reinterpret_cast<const ScoreRecord*>(bytes + SCORE_HEADER_SIZE);
+        mapped_count = (mapping_size - SCORE_HEADER_SIZE) / sizeof(ScoreRecord);
+        size_t valid_size = SCORE_HEADER_SIZE + mapped_count * sizeof(ScoreRecord);
+        if (valid_size != mapping_size && truncate(path.c_str(), static_cast<off_t>(valid_size)) != 0) {
+            std::cerr << "Warning: Could not repair " << path << std::endl;
+        }
+        has_header = true;
+    } else if (access(path.c_str(), F_OK) == 0) {
+        // Empty or shorter than a header: start it over
+        unlink(path.c_str());
+    }
+    
+    // Size the rank trees for the best score once, then count every run;
+    // the all-time lists are filled in the same pass
+    uint32_t max_scores[SCORE_DIFFICULTY_SLOTS] = {0};
+    for (size_t i = 0; i < mapped_count; i++) {
+        const ScoreRecord& record = mapped[i];
+        if (is_valid_difficulty(record.difficulty)) {
+            max_scores[record.difficulty] = std::max(max_scores[record.difficulty], record.score);
+        }
+    }
+    for (int difficulty = 1; difficulty < SCORE_DIFFICULTY_SLOTS; difficulty++) {
+        ranks[difficulty].resize(max_scores[difficulty]);
+    }
+    for (size_t i = 0; i < mapped_count; i++) {
+        const ScoreRecord& record = mapped[i];
+        if (is_valid_difficulty(record.difficulty)) {
+            ranks[record.difficulty].add(record.score);
+            insert_top(tops[record.difficulty][SCORE_WINDOW_ALL].runs, record);
+        }
+    }
+    // Windowed ranks start from the runs in each window today, so game over
+    // only moves them along
+    uint64_t now = static_cast<uint64_t>(time(nullptr));
+    for (int difficulty = 1; difficulty < SCORE_DIFFICULTY_SLOTS; difficulty++) {
+        tops[difficulty][SCORE_WINDOW_ALL].valid_until = UINT64_MAX;
+        tops[difficulty][SCORE_WINDOW_ALL].built = true;
+        for (int window = SCORE_WINDOW_ALL + 1; window < SCORE_WINDOW_COUNT; window++) {
+            slide_window(difficulty, static_cast<ScoreWindow>(window), now);
+        }
+    }
+    return true;
+}
+
+void ScoreStore::close() {
+    if (mapping) munmap(mapping, mapping_size);
+    mapping = nullptr;
+    mapping_size = 0;
+    mapped = nullptr;
+    mapped_count = 0;
+    added.clear();
+    has_header = false;
+    for (int difficulty = 0; difficulty < SCORE_DIFFICULTY_SLOTS; difficulty++) {
+        ranks[difficulty] = RankTree();
+        for (int window = 0; window < SCORE_WINDOW_COUNT; window++) {
+            tops[difficulty][window] = TopList();
+            window_ranks[difficulty][window] = WindowRanks();
+        }
+    }
+}
+
+const ScoreRecord& ScoreStore::get_record(size_t index) const {
+    return index < mapped_count ? mapped[index] : added[index - mapped_count];
+}
+
+// Runs are stored in the order they ended, so the window is a suffix
+size_t ScoreStore::find_first_since(uint64_t timestamp) const {
+    size_t low = 0, high = get_count();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (get_record(middle).timestamp < timestamp) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+uint64_t ScoreStore::get_window_seconds(ScoreWindow window) {
+    switch (window) {
+        case SCORE_WINDOW_WEEK: return 7 * 24 * 3600;
+        case SCORE_WINDOW_DAY: return 24 * 3600;
+        default: return 0;
+    }
+}
+
+void ScoreStore::insert_top(std::vector<ScoreRecord>& runs, const ScoreRecord& record) {
+    if (runs.size() >= SCORE_TOP_K && !is_better_run(record, runs.back())) return;
+    
+    runs.insert(std::upper_bound(runs.begin(), runs.end(), record, is_better_run), record);
+    if (runs.size() > SCORE_TOP_K) runs.pop_back();
+}
+
+void ScoreStore::build_top(int difficulty, ScoreWindow window, uint64_t now) {
+    TopList& top = tops[difficulty][window];
+    uint64_t seconds = get_window_seconds(window);
+    size_t first = seconds && now > seconds ? find_first_since(now - seconds) : 0;
+    
+    top.runs.clear();
+    for (size_t i = first; i < get_count(); i++) {
+        const ScoreRecord& record = get_record(i);
+        if (record.difficulty == difficulty) insert_top(top.runs, record);
+    }
+    
+    top.valid_until = UINT64_MAX;
+    if (seconds) {
+        for (const ScoreRecord& record : top.runs) {
+            top.valid_until = std::min(top.valid_until, record.timestamp + seconds);
+        }
+    }
+    top.built = true;
+}
+
+void ScoreStore::rebuild_ranks(int difficulty, uint32_t max_score) {
+    RankTree& tree = ranks[difficulty];
+    tree.resize(max_score);
+    for (size_t i = 0; i < get_count(); i++) {
+        const ScoreRecord& record = get_record(i);
+        if (record.difficulty == difficulty) tree.add(record.score);
+    }
+    
+    // Window trees share the all-time tree's size
+    for (int window = SCORE_WINDOW_ALL + 1; window < SCORE_WINDOW_COUNT; window++) {
+        WindowRanks& window_tree = window_ranks[difficulty][window];
+        if (window_tree.built) build_window_ranks(difficulty, static_cast<ScoreWindow>(window), window_tree.first);
+    }
+}
+
+void ScoreStore::build_window_ranks(int difficulty, ScoreWindow window, size_t first) {
+    WindowRanks& window_tree = window_ranks[difficulty][window];
+    window_tree.tree.clear_to_size_of(ranks[difficulty]);
+    for (size_t i = first; i < get_count(); i++) {
+        const ScoreRecord& record = get_record(i);
+        if (record.difficulty == difficulty) window_tree.tree.add(record.score);
+    }
+    window_tree.first = first;
+    window_tree.built = true;
+}
+
+// Moves the window start to now, taking out the runs it passes (or putting
+// them back if now went backwards); each run costs O(log n) once
+void ScoreStore::slide_window(int difficulty, ScoreWindow window, uint64_t now) {
+    uint64_t seconds = get_window_seconds(window);
+    size_t first = now > seconds ? find_first_since(now - seconds) : 0;
+    
+    WindowRanks& window_tree = window_ranks[difficulty][window];
+    if (!window_tree.built) {
+        build_window_ranks(difficulty, window, first);
+        return;
+    }
+    while (window_tree.first < first) {
+        const ScoreRecord& record = get_record(window_tree.first++);
+        if (record.difficulty == difficulty) window_tree.tree.remove(record.score);
+    }
+    while (window_tree.first > first) {
+        const ScoreRecord& record = get_record(--window_tree.first);
+        if (record.difficulty == difficulty) window_tree.tree.add(record.score);
+    }
+}
+
+void ScoreStore::add(const ScoreRecord& run) {
+    if (path.empty() || !is_valid_difficulty(run.difficulty)) return;
+    
+    // Windows are found by binary search on time, so a clock stepped back
+    // (NTP, a manual change) must not put a run before the one saved last
+    ScoreRecord record = run;
+    if (get_count() > 0) {
+        record.timestamp = std::max(record.timestamp, get_record(get_count() - 1).timestamp);
+    }
+    
+    // Saved first so the file always has the header before any run
+    std::string bytes;
+    if (!has_header) {
+        uint32_t fields[2] = {SCORE_STORE_VERSION, static_cast<uint32_t>(sizeof(ScoreRecord))};
+        bytes.assign(SCORE_MAGIC, sizeof(SCORE_MAGIC));
+        bytes.append(reinterpret_cast<const char*>(fields), sizeof(fields));
+        has_header = true;
+    }
+    bytes.append(reinterpret_cast<const char*>(&record), sizeof(record));
+    if (writer) {
+        writer->append(path, bytes);
+    } else {
+        SaveWriter::append_file(path, bytes);
+    }
+    added.push_back(record);
+    
+    // Trees only grow by doubling, so rebuilding stays amortized O(log n)
+    RankTree& tree = ranks[record.difficulty];
+    uint32_t size = tree.counts.empty() ? 0 : static_cast<uint32_t>(tree.counts.size()) - 1;
+    if (record.score >= size && size < SCORE_RANK_LIMIT) {
+        rebuild_ranks(record.difficulty, record.score);
+    } else {
+        tree.add(record.score);
+        
+        // The newest run is inside every window
+        for (int window = SCORE_WINDOW_ALL + 1; window < SCORE_WINDOW_COUNT; window++) {
+            WindowRanks& window_tree = window_ranks[record.difficulty][window];
+            if (window_tree.built) window_tree.tree.add(record.score);
+        }
+    }
+    
+    for (int window = 0; window < SCORE_WINDOW_COUNT; window++) {
+        TopList& top = tops[record.difficulty][window];
+        if (!top.built) continue;
+        insert_top(top.runs, record);
+        uint64_t seconds = get_window_seconds(static_cast<ScoreWindow>(window));
+        if (seconds) top.valid_until = std::min(top.valid_until, record.timestamp + seconds);
+    }
+}
+
+const std::vector<ScoreRecord>& ScoreStore::get_top(int difficulty, ScoreWindow window, uint64_t now) {
+    if (!is_valid_difficulty(difficulty)) difficulty = 0;
+    
+    TopList& top = tops[difficulty][window];
+    if (difficulty > 0 && (!top.built || now >= top.valid_until)) {
+        build_top(difficulty, window, now);
+    }
+    return top.runs;
+}
+
+uint32_t ScoreStore::get_rank(int difficulty, uint32_t score) const {
+    if (!is_valid_difficulty(difficulty)) return 0;
+    return ranks[difficulty].count_above(score) + 1;
+}
+
+uint32_t ScoreStore::get_rank(int difficulty, uint32_t score, ScoreWindow window, uint64_t now) {
+    if (window == SCORE_WINDOW_ALL) return get_rank(difficulty, score);
+    if (!is_valid_difficulty(difficulty)) return 0;
+    
+    slide_window(difficulty, window, now);
+    return window_ranks[difficulty][window].tree.count_above(score) + 1;
+}
+
+uint32_t ScoreStore::get_run_count(int difficulty) const {
+    return is_valid_difficulty(difficulty) ? ranks[difficulty].total : 0;
+}
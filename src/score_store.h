@@ -0,0 +1,126 @@
+#ifndef SCORE_STORE_H
+#define SCORE_STORE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class SaveWriter;
+
+// One finished run, stored as-is in scores.db
+struct ScoreRecord {
+    uint64_t timestamp;       // Unix seconds at game over
+    uint32_t score;
+    uint32_t duration_ms;
+    uint32_t length;
+    uint16_t level;
+    uint8_t difficulty;       // Difficulty value, 1-3
+    uint8_t reserved;
+    uint32_t max_combo;
+    uint32_t foods_eaten;
+};
+
+// scores.db: "SNKSCR1\0", u32 version, u32 record size, then records in the
+// order the runs ended, their timestamps never decreasing. Native
+// little-endian layout, like the asset archive.
+const char* const SCORE_STORE_PATH = "scores.db";
+const uint32_t SCORE_STORE_VERSION = 1;
+const size_t SCORE_TOP_K = 100;
+const int SCORE_DIFFICULTY_SLOTS = 4;        // Indexed by difficulty value
+const uint32_t SCORE_RANK_LIMIT = 1u << 20;  // Exact ranks below this score
+
+enum ScoreWindow {
+    SCORE_WINDOW_ALL,
+    SCORE_WINDOW_WEEK,
+    SCORE_WINDOW_DAY,
+    SCORE_WINDOW_COUNT
+};
+
+// Local leaderboard over every run ever played. The file is memory-mapped
+// at open and never copied; runs added later are appended to it through
+// the SaveWriter and kept in memory. Per difficulty, ranks come from
+// Fenwick trees of score counts (O(log n) to insert and to rank): one over
+// every run, and one per window that runs leave, O(log n) each, as the
+// window start passes them. The best SCORE_TOP_K runs of each window are
+// kept sorted; windowed lists are rebuilt from the end of the file, which
+// is in time order, only when one of their runs ages out.
+class ScoreStore {
+private:
+    // Counts of runs per score; prefix sums give ranks
+    struct RankTree {
+        std::vector<uint32_t> counts;
+        uint32_t total;
+        
+        RankTree() : total(0) {}
+        void add(uint32_t score);
+        void remove(uint32_t score);
+        uint32_t count_above(uint32_t score) const;
+        void resize(uint32_t max_score);
+        void clear_to_size_of(const RankTree& other);
+    };
+    
+    // Runs of one difficulty from first to the end of the store
+    struct WindowRanks {
+        RankTree tree;
+        size_t first;
+        bool built;
+        
+        WindowRanks() : first(0), built(false) {}
+    };
+    
+    struct TopList {
+        std::vector<ScoreRecord> runs;  // Best first
+        uint64_t valid_until;           // A run leaves the window at this time
+        bool built;
+        
+        TopList() : valid_until(0), built(false) {}
+    };
+    
+    const ScoreRecord* mapped;       // Records in the mapping
+    size_t mapped_count;
+    void* mapping;
+    size_t mapping_size;
+    std::vector<ScoreRecord> added;  // Runs since open
+    std::string path;
+    bool has_header;
+    SaveWriter* writer;
+    
+    RankTree ranks[SCORE_DIFFICULTY_SLOTS];
+    WindowRanks window_ranks[SCORE_DIFFICULTY_SLOTS][SCORE_WINDOW_COUNT];  // SCORE_WINDOW_ALL unused
+    TopList tops[SCORE_DIFFICULTY_SLOTS][SCORE_WINDOW_COUNT];
+    
+    size_t get_count() const { return mapped_count + added.size(); }
+    const ScoreRecord& get_record(size_t index) const;
+    size_t find_first_since(uint64_t timestamp) const;
+    void build_top(int difficulty, ScoreWindow window, uint64_t now);
+    void rebuild_ranks(int difficulty, uint32_t max_score);
+    void build_window_ranks(int difficulty, ScoreWindow window, size_t first);
+    void slide_window(int difficulty, ScoreWindow window, uint64_t now);
+    
+    static uint64_t get_window_seconds(ScoreWindow window);
+    static void insert_top(std::vector<ScoreRecord>& runs, const ScoreRecord& record);
+    
+public:
+    ScoreStore();
+    ~ScoreStore();
+    
+    // Maps path and indexes it; a missing file is an empty store. False for
+    // a file from another version, which is left alone and not added to.
+    bool open(const std::string& path);
+    void close();
+    
+    void set_save_writer(SaveWriter* save_writer) { writer = save_writer; }
+    
+    // The run's timestamp is raised to the latest saved one if the clock went back
+    void add(const ScoreRecord& run);
+    
+    // Best runs of a difficulty within the window ending now
+    const std::vector<ScoreRecord>& get_top(int difficulty, ScoreWindow window, uint64_t now);
+    
+    // 1 + runs with a strictly higher score
+    uint32_t get_rank(int difficulty, uint32_t score) const;
+    uint32_t get_rank(int difficulty, uint32_t score, ScoreWindow window, uint64_t now);
+    uint32_t get_run_count(int difficulty) const;
+};
+
+#endif // SCORE_STORE_H
@@ -0,0 +1,45 @@
+#include "food.h"
+
+// Food implementation
+Food::Food() {
+    x = 0;
+    y = 0;
+    active = false;
+    type = FOOD_NORMAL;
+    spawn_time = 0;
+}
+
+bool Food::spawn(const Snake& snake, uint32_t current_time, Prng& rng) {
+    // Pick straight from the free cells so a nearly full board costs the same
+    int free_count = snake.get_free_cell_count();
+    if (free_count == 0) {
+        active = false;
+        return false;
+    }
+    
+    Segment cell = snake.get_free_cell(rng.next_below(free_count));
+    x = cell.x;
+    y = cell.y;
+    
+    active = true;
+    spawn_time = current_time;
+    return true;
+}
+
+bool Food::check_collision(const Snake& snake) const {
+    if (!active) return false;
+    return snake.get_head().x == x && snake.get_head().y == y;
+}
+
+FoodType Food::get_random_type(int level, int foods_eaten, Prng& rng) {
+    int random = rng.next_below(100);
+    
+    // Base probabilities that change with level
+    if (random < 50) return FOOD_NORMAL;      // 50% normal food
+    if (random < 65) return FOOD_SPEED;       // 15% speed boost
+    if (random < 75) return FOOD_DOUBLE;      // 10% double score
+    if (random < 85) return FOOD_GOLDEN;      // 10% golden food
+    if (random < 92) return FOOD_SHRINK;      // 7% shrink food
+    if (random < 98) return FOOD_PHASE;       // 6% phase food
+    return FOOD_MEGA;                         // 2% mega food
+}
@@ -0,0 +1,22 @@
+#ifndef SIM_FOOD_H
+#define SIM_FOOD_H
+
+#include "sim_types.h"
+#include "snake.h"
+#include "prng.h"
+
+// Food structure
+struct Food {
+    int x, y;
+    bool active;
+    FoodType type;
+    uint32_t spawn_time;
+    
+    Food();
+    // Returns false (and leaves the food inactive) when the board is full
+    bool spawn(const Snake& snake, uint32_t current_time, Prng& rng);
+    bool check_collision(const Snake& snake) const;
+    FoodType get_random_type(int level, int foods_eaten, Prng& rng);
+};
+
+#endif // SIM_FOOD_H
@@ -0,0 +1,53 @@
+#include "free_cell_set.h"
+
+FreeCellSet::FreeCellSet(int cell_count)
+    : cells(cell_count), positions(cell_count), count(0) {
+    fill();
+}
+
+void FreeCellSet::fill() {
+    for (size_t i = 0; i < cells.size(); i++) {
+        cells[i] = static_cast<int>(i);
+        positions[i] = static_cast<int>(i);
+    }
+    count = cells.size();
+}
+
+void FreeCellSet::insert(int cell) {
+    if (contains(cell)) return;
+    
+    cells[count] = cell;
+    positions[cell] = static_cast<int>(count);
+    count++;
+}
+
+bool FreeCellSet::assign(const std::vector<int>& order) {
+    if (order.size() != count) return false;
+    
+    // Every cell must be in the set and listed once
+    std::vector<bool> seen(positions.size(), false);
+    for (int cell : order) {
+        if (cell < 0 || cell >= static_cast<int>(positions.size()) || !contains(cell) || seen[cell]) {
+            return false;
+        }
+        seen[cell] = true;
+    }
+    
+    for (size_t slot = 0; slot < count; slot++) {
+        cells[slot] = order[slot];
+        positions[order[slot]] = static_cast<int>(slot);
+    }
+    return true;
+}
+
+void FreeCellSet::remove(int cell) {
+    if (!contains(cell)) return;
+    
+    // Move the last free cell into the hole
+    int slot = positions[cell];
+    int last = cells[count - 1];
+    cells[slot] = last;
+    positions[last] = slot;
+    positions[cell] = -1;
+    count--;
+}
@@ -0,0 +1,35 @@
+#ifndef SIM_FREE_CELL_SET_H
+#define SIM_FREE_CELL_SET_H
+
+#include <cstddef>
+#include <vector>
+
+// Dense set of free grid cells (as y * GRID_WIDTH + x indices).
+// Insert, remove and pick-by-slot are all O(1): removal swaps the cell
+// with the last one, and positions[] maps a cell back to its slot.
+// The slot order depends on the history of inserts and removes, so it is
+// saved and restored with the rest of the game (see SimState).
+class FreeCellSet {
+private:
+    std::vector<int> cells;      // Slots [0, count) hold the free cells
+    std::vector<int> positions;  // Cell -> slot in cells, or -1 when occupied
+    size_t count;
+    
+public:
+    explicit FreeCellSet(int cell_count);
+    
+    void fill();
+    void insert(int cell);
+    void remove(int cell);
+    
+    // Puts the same cells in the slots given by order; false, and nothing
+    // changed, when order is not a permutation of the set
+    bool assign(const std::vector<int>& order);
+    void get_order(std::vector<int>& order) const { order.assign(cells.begin(), cells.begin() + count); }
+    bool contains(int cell) const { return positions[cell] >= 0; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    int get(size_t slot) const { return cells[slot]; }
+};
+
+#endif // SIM_FREE_CELL_SET_H
@@ -0,0 +1,46 @@
+#include "powerups.h"
+
+// PowerUps implementation
+PowerUps::PowerUps() {
+    init();
+}
+
+void PowerUps::init() {
+    speed_boost = false;
+    double_score = false;
+    phase_through_walls = false;
+    speed_end_time = 0;
+    double_score_end_time = 0;
+    phase_end_time = 0;
+    combo_multiplier = 1;
+    combo_count = 0;
+    last_food_time = 0;
+}
+
+void PowerUps::update(uint32_t current_time) {
+    if (speed_boost && current_time >= speed_end_time) {
+        speed_boost = false;
+    }
+    
+    if (double_score && current_time >= double_score_end_time) {
+        double_score = false;
+    }
+    
+    if (phase_through_walls && current_time >= phase_end_time) {
+        phase_through_walls = false;
+    }
+    
+    // Update combo system
+    if (current_time - last_food_time > 3000) { // 3 seconds timeout
+        combo_count = 0;
+        combo_multiplier = 1;
+    }
+}
+
+int PowerUps::get_score_multiplier() const {
+    int multiplier = combo_multiplier;
+    if (double_score) {
+        multiplier *= 2;
+    }
+    return multiplier;
+}
@@ -0,0 +1,27 @@
+#ifndef SIM_POWERUPS_H
+#define SIM_POWERUPS_H
+
+#include <cstdint>
+
+// Power-up states
+struct PowerUps {
+    bool speed_boost;
+    bool double_score;
+    bool phase_through_walls;
+    uint32_t speed_end_time;
+    uint32_t double_score_end_time;
+    uint32_t phase_end_time;
+    int combo_multiplier;
+    int combo_count;
+    uint32_t last_food_time;
+    
+    PowerUps();
+    void init();
+    void update(uint32_t current_time);
+    bool is_speed_active() const { return speed_boost; }
+    bool is_double_score_active() const { return double_score; }
+    bool is_phase_active() const { return phase_through_walls; }
+    int get_score_multiplier() const;
+};
+
+#endif // SIM_POWERUPS_H
@@ -0,0 +1,60 @@
+#ifndef SIM_PRNG_H
+#define SIM_PRNG_H
+
+#include <cstdint>
+
+// PCG32 pseudo-random generator (O'Neill, pcg-random.org).
+// Each instance owns its state, so parallel games never share a lock or a
+// sequence, and a (seed, stream) pair always replays the same numbers.
+class Prng {
+private:
+    uint64_t state;
+    uint64_t increment;
+    
+public:
+    explicit Prng(uint64_t seed_value = 0, uint64_t stream = 0) {
+        seed(seed_value, stream);
+    }
+    
+    void seed(uint64_t seed_value, uint64_t stream = 0) {
+        state = 0;
+        increment = (stream << 1u) | 1u;
+        next();
+        state += seed_value;
+        next();
+    }
+    
+    uint32_t next() {
+        uint64_t old_state = state;
+        state = old_state * 6364136223846793005ULL + increment;
+        uint32_t xorshifted = static_cast<uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+        uint32_t rotation = static_cast<uint32_t>(old_state >> 59u);
+        return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+    }
+    
+    // Uniform in [0, bound), without modulo bias
+    uint32_t next_below(uint32_t bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        for (;;) {
+            uint32_t value = next();
+            if (value >= threshold) {
+                return value % bound;
+            }
+        }
+    }
+    
+    // Uniform in [0, 1)
+    float next_float() {
+        return (next() >> 8) * (1.0f / 16777216.0f);
+    }
+    
+    // Raw generator state, for replay keyframes
+    uint64_t get_state() const { return state; }
+    uint64_t get_increment() const { return increment; }
+    void set_state(uint64_t state_value, uint64_t increment_value) {
+        state = state_value;
+        increment = increment_value | 1u;
+    }
+};
+
+#endif // SIM_PRNG_H
@@ -0,0 +1,581 @@
+#include "replay.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static const char REPLAY_MAGIC[8] = {'S', 'N', 'K', 'R', 'P', 'L', '1', '\0'};
+
+// Keyframe body encodings: 4-bit steps from each segment to the next, or
+// plain coordinates when the body has a jump steps cannot express. Most
+// keyframes use BODY_DELTA: the steps the head took since the previous
+// keyframe, with the rest of the body kept from that keyframe, so a long
+// snake costs what it moved rather than its length.
+enum BodyEncoding {
+    BODY_STEPS = 0,
+    BODY_RAW = 1,
+    BODY_DELTA = 2
+};
+
+enum BodyStep {
+    STEP_UP,
+    STEP_DOWN,
+    STEP_LEFT,
+    STEP_RIGHT,
+    STEP_SAME,      // Freshly grown segments stacked on the tail
+    STEP_INVALID
+};
+
+// Longest body a keyframe may claim, so a corrupt size cannot exhaust memory
+static const uint64_t MAX_REPLAY_BODY = GRID_WIDTH * GRID_HEIGHT * 4;
+
+static void put_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+static void put_signed(std::string& out, int64_t value) {
+    put_varint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+// Bounded reader over the file; any read past the end marks it failed
+struct VarintReader {
+    const std::string& data;
+    size_t pos;
+    size_t end;
+    bool failed;
+    
+    VarintReader(const std::string& bytes, size_t start, size_t limit)
+        : data(bytes), pos(start), end(limit), failed(false) {}
+    
+    uint64_t get() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos >= end) break;
+            uint8_t byte = static_cast<uint8_t>(data[pos++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        failed = true;
+        return 0;
+    }
+    
+    int64_t get_signed() {
+        uint64_t value = get();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+    
+    uint8_t get_byte() {
+        if (pos >= end) {
+            failed = true;
+            return 0;
+        }
+        return static_cast<uint8_t>(data[pos++]);
+    }
+};
+
+// Step from one segment to the next, counting a wrap through a wall as one cell
+static BodyStep get_step(const Segment& from, const Segment& to) {
+    int dx = to.x - from.x;
+    int dy = to.y - from.y;
+    if (dx == GRID_WIDTH - 1) dx = -1;
+    if (dx == -(GRID_WIDTH - 1)) dx = 1;
+    if (dy == GRID_HEIGHT - 1) dy = -1;
+    if (dy == -(GRID_HEIGHT - 1)) dy = 1;
+    
+    if (dx == 0 && dy == 0) return STEP_SAME;
+    if (dx == 0 && dy == -1) return STEP_UP;
+    if (dx == 0 && dy == 1) return STEP_DOWN;
+    if (dx == -1 && dy == 0) return STEP_LEFT;
+    if (dx == 1 && dy == 0) return STEP_RIGHT;
+    return STEP_INVALID;
+}
+
+static Segment apply_step(const Segment& from, int step) {
+    Segment to = from;
+    switch (step) {
+        case STEP_UP: to.y--; break;
+        case STEP_DOWN: to.y++; break;
+        case STEP_LEFT: to.x--; break;
+        case STEP_RIGHT: to.x++; break;
+        default: break;
+    }
+    // Undo the wrap the encoder folded into the step
+    if (from.x >= 0 && from.x < GRID_WIDTH) {
+        if (to.x < 0) to.x = GRID_WIDTH - 1;
+        if (to.x >= GRID_WIDTH) to.x = 0;
+    }
+    if (from.y >= 0 && from.y < GRID_HEIGHT) {
+        if (to.y < 0) to.y = GRID_HEIGHT - 1;
+        if (to.y >= GRID_HEIGHT) to.y = 0;
+    }
+    return to;
+}
+
+// Steps from body[start] back to the head, packed two to a byte
+static void put_steps_to_head(std::string& out, const std::vector<Segment>& body, size_t start) {
+    for (size_t i = start; i > 0; i -= 2) {
+        uint8_t packed = static_cast<uint8_t>(get_step(body[i], body[i - 1]));
+        if (i > 1) {
+            packed |= static_cast<uint8_t>(get_step(body[i - 1], body[i - 2]) << 4);
+        }
+        out += static_cast<char>(packed);
+        if (i == 1) break;
+    }
+}
+
+// Where the previous keyframe's body starts inside body, with every later
+// segment matching it and the new head reachable by steps; 0 when it does
+// not fit
+static size_t find_delta_start(const std::vector<Segment>& body, const std::vector<Segment>& previous) {
+    if (previous.empty()) return 0;
+    
+    for (size_t start = 1; start < body.size(); start++) {
+        if (body[start].x != previous[0].x || body[start].y != previous[0].y) continue;
+        if (body.size() - start > previous.size()) continue;
+        
+        bool kept = true;
+        for (size_t i = start; i < body.size() && kept; i++) {
+            kept = body[i].x == previous[i - start].x && body[i].y == previous[i - start].y;
+        }
+        for (size_t i = start; i > 0 && kept; i--) {
+            BodyStep step = get_step(body[i], body[i - 1]);
+            Segment decoded = apply_step(body[i], step);
+            kept = step != STEP_INVALID && decoded.x == body[i - 1].x && decoded.y == body[i - 1].y;
+        }
+        if (kept) return start;
+    }
+    return 0;
+}
+
+static void encode_body(std::string& out, const std::vector<Segment>& body,
+                        const std::vector<Segment>& previous) {
+    put_varint(out, body.size());
+    if (body.empty()) return;
+    
+    size_t delta_start = find_delta_start(body, previous);
+    if (delta_start > 0) {
+        out += static_cast<char>(BODY_DELTA);
+        put_varint(out, delta_start);
+        put_steps_to_head(out, body, delta_start);
+        return;
+    }
+    
+    // Steps are only usable when decoding them gives back the same cells
+    bool use_steps = true;
+    for (size_t i = 1; i < body.size() && use_steps; i++) {
+        BodyStep step = get_step(body[i - 1], body[i]);
+        Segment decoded = apply_step(body[i - 1], step);
+        use_steps = step != STEP_INVALID && decoded.x == body[i].x && decoded.y == body[i].y;
+    }
+    
+    out += static_cast<char>(use_steps ? BODY_STEPS : BODY_RAW);
+    put_signed(out, body[0].x);
+    put_signed(out, body[0].y);
+    if (use_steps) {
+        for (size_t i = 1; i < body.size(); i += 2) {
+            uint8_t packed = static_cast<uint8_t>(get_step(body[i - 1], body[i]));
+            if (i + 1 < body.size()) {
+                packed |= static_cast<uint8_t>(get_step(body[i], body[i + 1]) << 4);
+            }
+            out += static_cast<char>(packed);
+        }
+    } else {
+        for (size_t i = 1; i < body.size(); i++) {
+            put_signed(out, body[i].x);
+            put_signed(out, body[i].y);
+        }
+    }
+}
+
+static bool decode_body(VarintReader& in, std::vector<Segment>& body,
+                        const std::vector<Segment>& previous) {
+    uint64_t count = in.get();
+    if (in.failed || count > MAX_REPLAY_BODY) return false;
+    body.resize(static_cast<size_t>(count));
+    if (count == 0) return true;
+    
+    uint8_t encoding = in.get_byte();
+    if (encoding == BODY_DELTA) {
+        uint64_t start = in.get();
+        if (in.failed || start == 0 || start >= count || count - start > previous.size()) return false;
+        
+        for (size_t i = static_cast<size_t>(start); i < body.size(); i++) {
+            body[i] = previous[i - static_cast<size_t>(start)];
+        }
+        for (size_t i = static_cast<size_t>(start); i > 0; i -= 2) {
+            uint8_t packed = in.get_byte();
+            body[i - 1] = apply_step(body[i], packed & 0x0F);
+            if (i == 1) break;
+            body[i - 2] = apply_step(body[i - 1], packed >> 4);
+        }
+        return !in.failed;
+    }
+    
+    body[0].x = static_cast<int>(in.get_signed());
+    body[0].y = static_cast<int>(in.get_signed());
+    if (encoding == BODY_STEPS) {
+        for (size_t i = 1; i < body.size(); i += 2) {
+            uint8_t packed = in.get_byte();
+            body[i] = apply_step(body[i - 1], packed & 0x0F);
+            if (i + 1 < body.size()) {
+                body[i + 1] = apply_step(body[i], packed >> 4);
+            }
+        }
+    } else if (encoding == BODY_RAW) {
+        for (size_t i = 1; i < body.size(); i++) {
+            body[i].x = static_cast<int>(in.get_signed());
+            body[i].y = static_cast<int>(in.get_signed());
+        }
+    } else {
+        return false;
+    }
+    return !in.failed;
+}
+
+// Free-cell slot order as the slots that differ from the previous
+// keyframe's: the cell count, then each changed slot as its distance past
+// the last one written and the cell it holds. A move changes a slot or
+// two, so this grows with what happened rather than with the board.
+static void encode_free_cells(std::string& out, const std::vector<int>& order,
+                              const std::vector<int>& previous) {
+    put_varint(out, order.size());
+    size_t changed = 0;
+    for (size_t slot = 0; slot < order.size(); slot++) {
+        if (slot >= previous.size() || order[slot] != previous[slot]) changed++;
+    }
+    put_varint(out, changed);
+    
+    size_t next_slot = 0;
+    for (size_t slot = 0; slot < order.size(); slot++) {
+        if (slot < previous.size() && order[slot] == previous[slot]) continue;
+        put_varint(out, slot - next_slot);
+        put_varint(out, order[slot]);
+        next_slot = slot + 1;
+    }
+}
+
+static bool decode_free_cells(VarintReader& in, std::vector<int>& order, const std::vector<int>& previous) {
+    const uint64_t cell_count = GRID_WIDTH * GRID_HEIGHT;
+    uint64_t count = in.get();
+    uint64_t changed = in.get();
+    if (in.failed || count > cell_count || changed > count) return false;
+    
+    order.assign(previous.begin(), previous.begin() + std::min(previous.size(), static_cast<size_t>(count)));
+    order.resize(static_cast<size_t>(count), -1);
+    uint64_t next_slot = 0;
+    for (uint64_t i = 0; i < changed; i++) {
+        uint64_t slot = next_slot + in.get();
+        uint64_t cell = in.get();
+        if (in.failed || slot >= count || cell >= cell_count) return false;
+        order[static_cast<size_t>(slot)] = static_cast<int>(cell);
+        next_slot = slot + 1;
+    }
+    // Slots past the previous order must all have been written
+    return std::find(order.begin(), order.end(), -1) == order.end();
+}
+
+// What the first keyframe encodes against: no body, and the free cells in
+// the order a new game leaves them
+static SimState make_initial_state() {
+    SimState state = SimState();
+    Snake().get_free_cell_order(state.free_cells);
+    return state;
+}
+
+static const SimState& get_initial_state() {
+    static const SimState initial = make_initial_state();
+    return initial;
+}
+
+// previous is the keyframe before this one, or get_initial_state() for the first
+static void encode_state(std::string& out, const SimState& state, const SimState& previous) {
+    put_varint(out, state.time);
+    put_varint(out, state.last_move_time);
+    put_varint(out, state.base_move_delay);
+    out += static_cast<char>(state.direction | (state.next_direction << 2));
+    encode_body(out, state.body, previous.body);
+    encode_free_cells(out, state.free_cells, previous.free_cells);
+    
+    const Food& food = state.food;
+    out += static_cast<char>(food.active ? 1 : 0);
+    put_signed(out, food.x);
+    put_signed(out, food.y);
+    put_varint(out, food.type);
+    put_varint(out, food.spawn_time);
+    
+    const PowerUps& power_ups = state.power_ups;
+    out += static_cast<char>((power_ups.speed_boost ? 1 : 0) |
+                             (power_ups.double_score ? 2 : 0) |
+                             (power_ups.phase_through_walls ? 4 : 0));
+    put_varint(out, power_ups.speed_end_time);
+    put_varint(out, power_ups.double_score_end_time);
+    put_varint(out, power_ups.phase_end_time);
+    put_signed(out, power_ups.combo_multiplier);
+    put_signed(out, power_ups.combo_count);
+    put_varint(out, power_ups.last_food_time);
+    
+    put_varint(out, state.rng_state);
+    put_varint(out, state.rng_increment);
+    
+    put_varint(out, state.input_count);
+    for (int i = 0; i < state.input_count; i++) {
+        out += static_cast<char>(state.inputs[i].direction);
+        put_varint(out, state.inputs[i].time);
+    }
+    
+    put_varint(out, state.seed);
+    out += static_cast<char>(state.game_over ? 1 : 0);
+    put_signed(out, state.score);
+    put_signed(out, state.level);
+    put_signed(out, state.foods_needed_for_level);
+    put_signed(out, state.base_score_per_food);
+    put_signed(out, state.foods_eaten);
+    put_signed(out, state.special_foods_eaten);
+}
+
+static bool decode_state(VarintReader& in, SimState& state, const SimState& previous) {
+    state.time = static_cast<uint32_t>(in.get());
+    state.last_move_time = static_cast<uint32_t>(in.get());
+    state.base_move_delay = static_cast<uint32_t>(in.get());
+    uint8_t directions = in.get_byte();
+    state.direction = static_cast<Direction>(directions & 3);
+    state.next_direction = static_cast<Direction>((directions >> 2) & 3);
+    if (!decode_body(in, state.body, previous.body)) return false;
+    if (!decode_free_cells(in, state.free_cells, previous.free_cells)) return false;
+    
+    Food& food = state.food;
+    food.active = in.get_byte() != 0;
+    food.x = static_cast<int>(in.get_signed());
+    food.y = static_cast<int>(in.get_signed());
+    uint64_t food_type = in.get();
+    if (food_type >= FOOD_TYPE_COUNT) return false;
+    food.type = static_cast<FoodType>(food_type);
+    food.spawn_time = static_cast<uint32_t>(in.get());
+    
+    PowerUps& power_ups = state.power_ups;
+    uint8_t flags = in.get_byte();
+    power_ups.speed_boost = (flags & 1) != 0;
+    power_ups.double_score = (flags & 2) != 0;
+    power_ups.phase_through_walls = (flags & 4) != 0;
+    power_ups.speed_end_time = static_cast<uint32_t>(in.get());
+    power_ups.double_score_end_time = static_cast<uint32_t>(in.get());
+    power_ups.phase_end_time = static_cast<uint32_t>(in.get());
+    power_ups.combo_multiplier = static_cast<int>(in.get_signed());
+    power_ups.combo_count = static_cast<int>(in.get_signed());
+    power_ups.last_food_time = static_cast<uint32_t>(in.get());
+    
+    state.rng_state = in.get();
+    state.rng_increment = in.get();
+    
+    uint64_t input_count = in.get();
+    if (input_count > static_cast<uint64_t>(INPUT_QUEUE_CAPACITY)) return false;
+    state.input_count = static_cast<int>(input_count);
+    for (int i = 0; i < state.input_count; i++) {
+        state.inputs[i].direction = static_cast<Direction>(in.get_byte() & 3);
+        state.inputs[i].time = static_cast<uint32_t>(in.get());
+    }
+    
+    state.seed = in.get();
+    state.game_over = in.get_byte() != 0;
+    state.score = static_cast<int>(in.get_signed());
+    state.level = static_cast<int>(in.get_signed());
+    state.foods_needed_for_level = static_cast<int>(in.get_signed());
+    state.base_score_per_food = static_cast<int>(in.get_signed());
+    state.foods_eaten = static_cast<int>(in.get_signed());
+    state.special_foods_eaten = static_cast<int>(in.get_signed());
+    return !in.failed;
+}
+
+ReplayRecorder::ReplayRecorder()
+    : keyframe_interval(REPLAY_KEYFRAME_INTERVAL_MS), last_input_time(0),
+      next_keyframe_time(0), recording(false) {
+}
+
+void ReplayRecorder::begin(uint64_t seed, uint32_t move_delay, uint32_t tick_ms,
+                           uint32_t keyframe_interval_ms) {
+    data.clear();
+    data.append(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    put_varint(data, REPLAY_VERSION);
+    put_varint(data, tick_ms);
+    put_varint(data, keyframe_interval_ms);
+    put_varint(data, move_delay);
+    put_varint(data, seed);
+    
+    keyframe_interval = std::max(keyframe_interval_ms, 1u);
+    next_keyframe_time = keyframe_interval;
+    previous = get_initial_state();
+    last_input_time = 0;
+    recording = true;
+}
+
+void ReplayRecorder::record_input(uint32_t time, Direction direction) {
+    if (!recording) return;
+    
+    data += static_cast<char>(REPLAY_INPUT);
+    put_varint(data, (static_cast<uint64_t>(time - last_input_time) << 2) | direction);
+    last_input_time = time;
+}
+
+bool ReplayRecorder::after_step(const SnakeSim& sim) {
+    if (!recording || sim.is_game_over() || sim.get_time() < next_keyframe_time) return false;
+    
+    sim.save_state(scratch);
+    std::string payload;
+    encode_state(payload, scratch, previous);
+    std::swap(previous, scratch);
+    data += static_cast<char>(REPLAY_KEYFRAME);
+    put_varint(data, payload.size());
+    data += payload;
+    
+    while (next_keyframe_time <= sim.get_time()) {
+        next_keyframe_time += keyframe_interval;
+    }
+    return true;
+}
+
+void ReplayRecorder::finish(const SnakeSim& sim) {
+    if (!recording) return;
+    
+    data += static_cast<char>(REPLAY_END);
+    put_varint(data, sim.get_time());
+    put_signed(data, sim.get_score());
+    recording = false;
+}
+
+Replay::Replay()
+    : tick_ms(1), keyframe_interval(REPLAY_KEYFRAME_INTERVAL_MS), move_delay(0), seed(0),
+      complete(false), end_time(0), final_score(0) {
+}
+
+bool Replay::parse(const std::string& data) {
+    inputs.clear();
+    keyframes.clear();
+    complete = false;
+    
+    if (data.size() < sizeof(REPLAY_MAGIC) ||
+        std::memcmp(data.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0) {
+        return false;
+    }
+    
+    VarintReader in(data, sizeof(REPLAY_MAGIC), data.size());
+    uint64_t version = in.get();
+    tick_ms = static_cast<uint32_t>(in.get());
+    keyframe_interval = static_cast<uint32_t>(in.get());
+    move_delay = static_cast<uint32_t>(in.get());
+    seed = in.get();
+    if (in.failed || version != REPLAY_VERSION || tick_ms == 0) return false;
+    
+    // A recording cut short (crash, full disk) plays up to its last whole chunk
+    uint32_t input_time = 0;
+    while (in.pos < in.end && !complete) {
+        uint8_t tag = in.get_byte();
+        if (tag == REPLAY_INPUT) {
+            uint64_t packed = in.get();
+            if (in.failed) break;
+            input_time += static_cast<uint32_t>(packed >> 2);
+            ReplayInput input = {input_time, static_cast<Direction>(packed & 3)};
+            inputs.push_back(input);
+        } else if (tag == REPLAY_KEYFRAME) {
+            uint64_t size = in.get();
+            if (in.failed || size > in.end - in.pos) break;
+            VarintReader payload(data, in.pos, in.pos + static_cast<size_t>(size));
+            in.pos += static_cast<size_t>(size);
+            
+            ReplayKeyframe keyframe;
+            keyframe.first_input = inputs.size();
+            const SimState& previous = keyframes.empty() ? get_initial_state() : keyframes.back().state;
+            if (!decode_state(payload, keyframe.state, previous)) break;
+            if (!keyframes.empty() && keyframe.state.time <= keyframes.back().state.time) break;
+            keyframes.push_back(keyframe);
+        } else if (tag == REPLAY_END) {
+            end_time = static_cast<uint32_t>(in.get());
+            final_score = static_cast<int>(in.get_signed());
+            complete = !in.failed;
+        } else {
+            break;
+        }
+    }
+    return true;
+}
+
+bool Replay::load(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    
+    std::string data;
+    char buffer[4096];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.append(buffer, read);
+    }
+    std::fclose(file);
+    return parse(data);
+}
+
+ReplayPlayer::ReplayPlayer(const Replay& source)
+    : replay(source), next_input(0) {
+    restart();
+}
+
+void ReplayPlayer::restart() {
+    sim.set_clock(nullptr);
+    sim.get_manual_clock().set(0);
+    sim.reset(replay.move_delay, replay.seed);
+    next_input = 0;
+}
+
+// Same order as the live game: turns pressed at this time, then the tick
+void ReplayPlayer::run_tick() {
+    uint32_t time = sim.get_time();
+    const std::vector<ReplayInput>& inputs = replay.inputs;
+    while (next_input < inputs.size() && inputs[next_input].time <= time) {
+        sim.push_input(SimInput(inputs[next_input].direction));
+        next_input++;
+    }
+    
+    sim.get_manual_clock().advance(replay.tick_ms);
+    sim.step(SimInput());
+}
+
+void ReplayPlayer::seek(uint32_t time) {
+    // Last keyframe at or before the target
+    const std::vector<ReplayKeyframe>& keyframes = replay.keyframes;
+    std::vector<ReplayKeyframe>::const_iterator it = keyframes.end();
+    size_t low = 0, high = keyframes.size();
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (keyframes[middle].state.time <= time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low > 0) it = keyframes.begin() + (low - 1);
+    
+    // Going forward within the current interval is cheaper than reloading
+    bool ahead = time >= sim.get_time() &&
+                 (it == keyframes.end() || it->state.time <= sim.get_time());
+    if (!ahead) {
+        if (it == keyframes.end()) {
+            restart();
+        } else {
+            sim.load_state(it->state);
+            next_input = it->first_input;
+        }
+    }
+    advance(time - sim.get_time());
+}
+
+void ReplayPlayer::advance(uint32_t ms) {
+    uint32_t target = sim.get_time() + ms;
+    while (!is_finished() && static_cast<int32_t>(target - sim.get_time()) >= static_cast<int32_t>(replay.tick_ms)) {
+        run_tick();
+    }
+}
+
+bool ReplayPlayer::is_finished() const {
+    return sim.is_game_over() || (replay.complete && sim.get_time() >= replay.end_time);
+}
@@ -0,0 +1,126 @@
+#ifndef SIM_REPLAY_H
+#define SIM_REPLAY_H
+
+#include "snake_sim.h"
+#include <string>
+#include <vector>
+
+// Replay file: a game is its seed plus the turns the simulation accepted,
+// each with the simulation time it was pushed at. Keyframes with the full
+// SimState every REPLAY_KEYFRAME_INTERVAL_MS let a player seek without
+// simulating from the start. A keyframe stores the snake as the moves made
+// since the keyframe before it, and the free-cell slot order food picks
+// from as the slots that changed since then, so it costs about the same
+// whatever the snake's length. Integers are LEB128 varints (signed ones
+// zigzagged).
+//
+//   "SNKRPL1\0"
+//   varint version, tick_ms, keyframe_interval_ms, move_delay, seed
+//   chunks, each starting with a tag byte:
+//     REPLAY_INPUT     varint (time since the previous input << 2 | direction)
+//     REPLAY_KEYFRAME  varint size, then the encoded SimState (its body and
+//                      free cells may refer to the previous keyframe's)
+//     REPLAY_END       varint end time, varint final score
+//
+// SimThread appends each keyframe to the file as it is taken, so a file cut
+// short by a crash or a full disk still plays up to its last whole chunk.
+//
+// Inputs are pushed between ticks, before the clock advances; a keyframe is
+// taken after the step of every tick whose time is a multiple of the
+// interval. Recorder and player follow the same order as SimThread.
+const uint32_t REPLAY_VERSION = 3;
+const uint32_t REPLAY_KEYFRAME_INTERVAL_MS = 10000;
+
+enum ReplayChunkTag {
+    REPLAY_INPUT = 1,
+    REPLAY_KEYFRAME = 2,
+    REPLAY_END = 3
+};
+
+struct ReplayInput {
+    uint32_t time;
+    Direction direction;
+};
+
+struct ReplayKeyframe {
+    SimState state;
+    size_t first_input;     // Inputs before this index are already applied
+};
+
+// Encodes a game in memory as it is played
+class ReplayRecorder {
+private:
+    std::string data;
+    uint32_t keyframe_interval;
+    uint32_t last_input_time;
+    uint32_t next_keyframe_time;
+    bool recording;
+    SimState scratch;
+    SimState previous;      // The last keyframe, which the next one encodes against
+    
+public:
+    ReplayRecorder();
+    
+    // Starts a new recording for a game just reset with this seed at time 0
+    void begin(uint64_t seed, uint32_t move_delay, uint32_t tick_ms,
+               uint32_t keyframe_interval_ms = REPLAY_KEYFRAME_INTERVAL_MS);
+    
+    // A turn push_input() accepted
+    void record_input(uint32_t time, Direction direction);
+    
+    // After every tick's step(); writes the keyframes, true when it wrote one
+    bool after_step(const SnakeSim& sim);
+    
+    void finish(const SnakeSim& sim);
+    
+    bool is_recording() const { return recording; }
+    const std::string& get_data() const { return data; }
+};
+
+// A decoded replay file
+struct Replay {
+    uint32_t tick_ms;
+    uint32_t keyframe_interval;
+    uint32_t move_delay;
+    uint64_t seed;
+    std::vector<ReplayInput> inputs;
+    std::vector<ReplayKeyframe> keyframes;   // In time order
+    bool complete;          // Has its REPLAY_END chunk
+    uint32_t end_time;
+    int final_score;
+    
+    Replay();
+    
+    // False for a file that is not a replay; a truncated one keeps what was read
+    bool parse(const std::string& data);
+    bool load(const std::string& path);
+};
+
+// Plays a Replay back at any speed: advance() runs the simulation as fast
+// as the CPU allows, so the caller scales real time by the speed it wants.
+class ReplayPlayer {
+private:
+    const Replay& replay;
+    SnakeSim sim;
+    size_t next_input;
+    
+    void run_tick();
+    
+public:
+    explicit ReplayPlayer(const Replay& source);
+    
+    void restart();
+    
+    // Jumps to the given time through the nearest keyframe at or before it,
+    // simulating at most one keyframe interval
+    void seek(uint32_t time);
+    
+    // Plays forward by ms of simulation time; stops early at game over
+    void advance(uint32_t ms);
+    
+    uint32_t get_time() const { return sim.get_time(); }
+    bool is_finished() const;
+    const SnakeSim& get_sim() const { return sim; }
+};
+
+#endif // SIM_REPLAY_H
@@ -0,0 +1,54 @@
+#include "sim_snapshot.h"
+#include <algorithm>
+
+void TickTimingStats::record(uint32_t lag, uint32_t tick_length) {
+    ticks++;
+    last_lag = lag;
+    max_lag = std::max(max_lag, lag);
+    total_lag += lag;
+    if (lag >= tick_length) late_ticks++;
+}
+
+SimSnapshot::SimSnapshot()
+    : generation(0), time(0), last_move_time(0), next_move_time(0), published_at(0),
+      running(false), game_over(false), score(0), level(1),
+      foods_eaten(0), foods_needed_for_level(1), special_foods_eaten(0), first_event_seq(0) {
+    // Sized for a full board so capturing never allocates
+    snake.segments.reserve(GRID_WIDTH * GRID_HEIGHT);
+    snake.previous.reserve(GRID_WIDTH * GRID_HEIGHT);
+    snake.capacity = GRID_WIDTH * GRID_HEIGHT;
+    events.reserve(16);
+}
+
+void SimSnapshot::capture(const SnakeSim& sim, const std::vector<Segment>& body_before_move) {
+    const Snake& source = sim.get_snake();
+    snake.segments.resize(source.get_length());
+    for (int i = 0; i < source.get_length(); i++) {
+        snake.segments[i] = source.get_segment(i);
+    }
+    snake.previous.assign(body_before_move.begin(), body_before_move.end());
+    snake.direction = source.direction;
+    snake.capacity = source.get_capacity();
+    
+    time = sim.get_time();
+    last_move_time = sim.get_last_move_time();
+    next_move_time = sim.get_next_move_time();
+    food = sim.get_food();
+    power_ups = sim.get_power_ups();
+    game_over = sim.is_game_over();
+    score = sim.get_score();
+    level = sim.get_level();
+    foods_eaten = sim.get_foods_eaten();
+    foods_needed_for_level = sim.get_foods_needed_for_level();
+    special_foods_eaten = sim.get_special_foods_eaten();
+    input_latency = sim.get_input_latency();
+}
+
+float SimSnapshot::get_move_progress(float ms_after) const {
+    float interval = static_cast<float>(static_cast<int32_t>(next_move_time - last_move_time));
+    if (interval <= 0.0f) return 1.0f;
+    
+    float since_move = static_cast<float>(static_cast<int32_t>(time - last_move_time)) + ms_after;
+    float progress = since_move / interval;
+    return std::max(0.0f, std::min(progress, 1.0f));
+}
@@ -0,0 +1,91 @@
+#ifndef SIM_SNAPSHOT_H
+#define SIM_SNAPSHOT_H
+
+#include "snake_sim.h"
+#include <vector>
+
+// Copy of the snake body, head first, along with the body as it was before
+// the latest move so the renderer can slide segments between the two
+struct SnakeSnapshot {
+    std::vector<Segment> segments;
+    std::vector<Segment> previous;
+    Direction direction;
+    size_t capacity;
+    
+    SnakeSnapshot() : direction(DIR_RIGHT), capacity(0) {}
+    int get_length() const { return static_cast<int>(segments.size()); }
+    const Segment& get_segment(size_t index) const { return segments[index]; }
+    size_t get_capacity() const { return capacity; }
+    
+    // Where segment index was before the latest move; a segment added by
+    // growth has no earlier cell and stays where it is
+    const Segment& get_previous_segment(size_t index) const {
+        return index < previous.size() ? previous[index] : segments[index];
+    }
+};
+
+// How late the ticks that moved the snake ran against their schedule, in microseconds
+struct TickTimingStats {
+    uint32_t ticks;
+    uint32_t late_ticks;    // Moves that ran a full tick or more behind
+    uint32_t last_lag;
+    uint32_t max_lag;
+    uint64_t total_lag;
+    
+    TickTimingStats() : ticks(0), late_ticks(0), last_lag(0), max_lag(0), total_lag(0) {}
+    void record(uint32_t lag, uint32_t tick_length);
+    float get_average() const { return ticks ? static_cast<float>(total_lag) / ticks : 0.0f; }
+};
+
+// Immutable view of the simulation handed from the simulation thread to the
+// renderer. Mirrors the SnakeSim getters so drawing code reads the same way.
+// Events carry increasing sequence numbers and stay in every snapshot until
+// the reader acknowledges them, so none are lost when snapshots are skipped.
+struct SimSnapshot {
+    uint32_t generation;    // Bumped by every reset, so stale games can be told apart
+    uint32_t time;
+    uint32_t last_move_time;
+    uint32_t next_move_time;
+    uint64_t published_at;  // Publisher's clock reading, to extrapolate time between snapshots
+    bool running;           // False while paused or over; time does not advance
+    
+    SnakeSnapshot snake;
+    Food food;
+    PowerUps power_ups;
+    bool game_over;
+    int score;
+    int level;
+    int foods_eaten;
+    int foods_needed_for_level;
+    int special_foods_eaten;
+    InputLatencyStats input_latency;
+    TickTimingStats tick_timing;
+    
+    std::vector<SimEvent> events;
+    uint32_t first_event_seq;  // Sequence number of events[0]
+    
+    SimSnapshot();
+    
+    // Copies the game state and the body before the latest move; events,
+    // generation and timing are set by the publisher
+    void capture(const SnakeSim& sim, const std::vector<Segment>& body_before_move);
+    
+    // Fraction of the current move interval elapsed, in [0, 1], at a point
+    // ms_after milliseconds past this snapshot: 0 just after a move, 1 when
+    // the next one is due
+    float get_move_progress(float ms_after) const;
+    
+    const SnakeSnapshot& get_snake() const { return snake; }
+    const Food& get_food() const { return food; }
+    const PowerUps& get_power_ups() const { return power_ups; }
+    bool is_game_over() const { return game_over; }
+    int get_score() const { return score; }
+    int get_level() const { return level; }
+    int get_foods_eaten() const { return foods_eaten; }
+    int get_foods_needed_for_level() const { return foods_needed_for_level; }
+    int get_special_foods_eaten() const { return special_foods_eaten; }
+    const InputLatencyStats& get_input_latency() const { return input_latency; }
+    const TickTimingStats& get_tick_timing() const { return tick_timing; }
+};
+
+#endif // SIM_SNAPSHOT_H
@@ -0,0 +1,36 @@
+#ifndef SIM_TYPES_H
+#define SIM_TYPES_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Board size in cells
+const int GRID_WIDTH = 40;
+const int GRID_HEIGHT = 30;
+
+// Direction enum
+enum Direction {
+    DIR_UP,
+    DIR_DOWN,
+    DIR_LEFT,
+    DIR_RIGHT
+};
+
+// Food types for magical power system
+enum FoodType {
+    FOOD_NORMAL,      // Regular food, grows snake
+    FOOD_SPEED,       // Temporary speed boost
+    FOOD_DOUBLE,      // Double score for next few foods
+    FOOD_GOLDEN,      // High score bonus
+    FOOD_SHRINK,      // Shrinks snake by 1-2 segments
+    FOOD_PHASE,       // Temporary wall phasing ability
+    FOOD_MEGA,        // Massive score bonus, very rare
+    FOOD_TYPE_COUNT
+};
+
+// Snake segment
+struct Segment {
+    int x, y;
+};
+
+#endif // SIM_TYPES_H
@@ -0,0 +1,194 @@
+#include "snake.h"
+#include <algorithm>
+
+// Snake implementation
+Snake::Snake(size_t capacity) : mask(0), head(0), length(0), max_length(capacity),
+                                free_cells(GRID_WIDTH * GRID_HEIGHT) {
+    // Round the ring up to a power of two so indices wrap with a mask
+    // (at least 4 slots for the starting body)
+    size_t ring_size = 4;
+    while (ring_size < max_length) {
+        ring_size <<= 1;
+    }
+    body.resize(ring_size);
+    mask = ring_size - 1;
+    
+    occupancy.resize((GRID_WIDTH * GRID_HEIGHT + 63) / 64);
+    
+    init();
+}
+
+void Snake::init() {
+    direction = DIR_RIGHT;
+    next_direction = DIR_RIGHT;
+    
+    int start_x = GRID_WIDTH / 2;
+    int start_y = GRID_HEIGHT / 2;
+    
+    head = 0;
+    length = 3;
+    body[0] = {start_x, start_y};
+    body[1] = {start_x - 1, start_y};
+    body[2] = {start_x - 2, start_y};
+    
+    std::fill(occupancy.begin(), occupancy.end(), 0);
+    free_cells.fill();
+    for (size_t i = 0; i < length; i++) {
+        set_cell(body[i]);
+    }
+    head_hit_body = false;
+}
+
+void Snake::restore(const std::vector<Segment>& segments, Direction dir, Direction next_dir,
+                    const std::vector<int>& free_cell_order) {
+    direction = dir;
+    next_direction = next_dir;
+    
+    head = 0;
+    length = std::min(segments.size(), max_length);
+    for (size_t i = 0; i < length; i++) {
+        body[i] = segments[i];
+    }
+    
+    std::fill(occupancy.begin(), occupancy.end(), 0);
+    free_cells.fill();
+    for (size_t i = 0; i < length; i++) {
+        const Segment& segment = get_segment(i);
+        if (in_bounds(segment)) set_cell(segment);
+    }
+    free_cells.assign(free_cell_order);
+    head_hit_body = false;
+}
+
+void Snake::move() {
+    direction = next_direction;
+    
+    Segment new_head = body[head];
+    
+    // Move head
+    switch (direction) {
+        case DIR_UP:
+            new_head.y--;
+            break;
+        case DIR_DOWN:
+            new_head.y++;
+            break;
+        case DIR_LEFT:
+            new_head.x--;
+            break;
+        case DIR_RIGHT:
+            new_head.x++;
+            break;
+    }
+    
+    // The tail leaves before the head arrives, so following it is not a collision
+    release_tail();
+    
+    // The body keeps its cells: stepping the head index back one slot
+    // drops the old tail and claims the new head cell
+    head = (head - 1) & mask;
+    body[head] = new_head;
+    
+    // Off-board heads are resolved in check_collision()
+    head_hit_body = false;
+    if (in_bounds(new_head)) {
+        head_hit_body = test_cell(new_head);
+        set_cell(new_head);
+    }
+}
+
+bool Snake::check_collision(bool phase_mode) {
+    Segment& head_cell = body[head];
+    
+    if (!in_bounds(head_cell)) {
+        // Check wall collision (unless in phase mode)
+        if (!phase_mode) {
+            return true;
+        }
+        
+        // In phase mode, wrap around walls and claim the cell we land on
+        head_cell.x = (head_cell.x + GRID_WIDTH) % GRID_WIDTH;
+        head_cell.y = (head_cell.y + GRID_HEIGHT) % GRID_HEIGHT;
+        head_hit_body = test_cell(head_cell);
+        set_cell(head_cell);
+    }
+    
+    // Check self collision
+    return head_hit_body;
+}
+
+void Snake::grow() {
+    if (length < max_length) {
+        // New tail segment starts on top of the current one
+        body[(head + length) & mask] = get_tail();
+        length++;
+    }
+}
+
+void Snake::shrink(int amount) {
+    for (int i = 0; i < amount && length > 3; i++) {
+        release_tail();
+        length--;
+    }
+}
+
+void Snake::release_tail() {
+    // Freshly grown segments stack on the tail cell; keep the bit until the last one leaves
+    const Segment& tail = get_tail();
+    if (length > 1) {
+        const Segment& before_tail = get_segment(length - 2);
+        if (before_tail.x == tail.x && before_tail.y == tail.y) return;
+    }
+    if (in_bounds(tail)) {
+        clear_cell(tail);
+    }
+}
+
+bool Snake::is_occupied(int x, int y) const {
+    Segment cell = {x, y};
+    return in_bounds(cell) && test_cell(cell);
+}
+
+Segment Snake::get_free_cell(int slot) const {
+    int cell = free_cells.get(slot);
+    Segment free_cell = {cell % GRID_WIDTH, cell / GRID_WIDTH};
+    return free_cell;
+}
+
+bool Snake::test_cell(const Segment& cell) const {
+    size_t index = cell.y * GRID_WIDTH + cell.x;
+    return (occupancy[index >> 6] >> (index & 63)) & 1;
+}
+
+void Snake::set_cell(const Segment& cell) {
+    size_t index = cell.y * GRID_WIDTH + cell.x;
+    occupancy[index >> 6] |= uint64_t(1) << (index & 63);
+    free_cells.remove(static_cast<int>(index));
+}
+
+void Snake::clear_cell(const Segment& cell) {
+    size_t index = cell.y * GRID_WIDTH + cell.x;
+    occupancy[index >> 6] &= ~(uint64_t(1) << (index & 63));
+    free_cells.insert(static_cast<int>(index));
+}
+
+bool Snake::is_valid_turn(Direction from, Direction to) {
+    // Prevent the snake from reversing into itself
+    switch (to) {
+        case DIR_UP:
+            return from != DIR_DOWN;
+        case DIR_DOWN:
+            return from != DIR_UP;
+        case DIR_LEFT:
+            return from != DIR_RIGHT;
+        case DIR_RIGHT:
+            return from != DIR_LEFT;
+    }
+    return false;
+}
+
+void Snake::change_direction(Direction new_dir) {
+    if (can_turn(new_dir)) {
+        next_direction = new_dir;
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef SIM_SNAKE_H
+#define SIM_SNAKE_H
+
+#include "sim_types.h"
+#include "free_cell_set.h"
+#include <vector>
+
+// Snake structure
+// The body lives in a fixed-capacity ring buffer so move, grow and shrink
+// are O(1) whatever the length. Segment 0 is the head.
+// A packed bitboard (one bit per grid cell) mirrors the cells the body
+// covers, so self-collision and free-cell queries are a single bit test.
+// The complementary free-cell set lets food pick an empty cell in O(1).
+struct Snake {
+private:
+    std::vector<Segment> body;  // Ring storage, power-of-two sized
+    size_t mask;
+    size_t head;                // Ring index of the head segment
+    size_t length;
+    size_t max_length;
+    
+    std::vector<uint64_t> occupancy;
+    FreeCellSet free_cells;
+    bool head_hit_body;         // Set by move() when the head entered an occupied cell
+    
+    static bool in_bounds(const Segment& cell) {
+        return cell.x >= 0 && cell.x < GRID_WIDTH && cell.y >= 0 && cell.y < GRID_HEIGHT;
+    }
+    bool test_cell(const Segment& cell) const;
+    void set_cell(const Segment& cell);
+    void clear_cell(const Segment& cell);
+    void release_tail();
+    
+public:
+    Direction direction;
+    Direction next_direction;
+    
+    explicit Snake(size_t capacity = GRID_WIDTH * GRID_HEIGHT);
+    ~Snake() = default;
+    void init();
+    
+    // Body from segments (head first), with the free cells in the slot
+    // order get_free_cell_order() gave when it was saved. Food picks a free
+    // cell by slot, so it only spawns where the original did with the same
+    // order; without a matching one the free cells are rebuilt in board order.
+    void restore(const std::vector<Segment>& segments, Direction dir, Direction next_dir,
+                 const std::vector<int>& free_cell_order = std::vector<int>());
+    void move();
+    bool check_collision(bool phase_mode = false);
+    void grow();
+    void shrink(int amount = 1);
+    bool can_turn(Direction new_dir) const { return is_valid_turn(direction, new_dir); }
+    static bool is_valid_turn(Direction from, Direction to);
+    void change_direction(Direction new_dir);
+    
+    // Segments from head (0) to tail (get_length() - 1)
+    const Segment& get_segment(size_t index) const { return body[(head + index) & mask]; }
+    const Segment& get_head() const { return body[head]; }
+    const Segment& get_tail() const { return get_segment(length - 1); }
+    int get_length() const { return static_cast<int>(length); }
+    bool is_occupied(int x, int y) const;
+    
+    // Empty cells, addressable by slot in [0, get_free_cell_count())
+    int get_free_cell_count() const { return static_cast<int>(free_cells.size()); }
+    Segment get_free_cell(int slot) const;
+    void get_free_cell_order(std::vector<int>& order) const { free_cells.get_order(order); }
+    size_t get_capacity() const { return max_length; }
+};
+
+#endif // SIM_SNAKE_H
@@ -0,0 +1,300 @@
+#include "snake_sim.h"
+#include <algorithm>
+
+SnakeSim::SnakeSim() : clock(nullptr), input_head(0), input_count(0),
+                       seed(0), game_over(false), score(0), level(1),
+                       foods_needed_for_level(5), base_score_per_food(10),
+                       foods_eaten(0), special_foods_eaten(0),
+                       last_move_time(0), base_move_delay(200) {
+    events.reserve(8);
+}
+
+void SnakeSim::reset(uint32_t move_delay, uint64_t game_seed) {
+    uint32_t current_time = now();
+    
+    seed = game_seed;
+    rng.seed(seed, SIM_RNG_STREAM);
+    
+    snake.init();
+    food.spawn(snake, current_time, rng);
+    food.type = food.get_random_type(1, 0, rng);
+    power_ups.init();
+    events.clear();
+    input_head = 0;
+    input_count = 0;
+    input_latency = InputLatencyStats();
+    
+    game_over = false;
+    score = 0;
+    level = 1;
+    foods_needed_for_level = 5;
+    foods_eaten = 0;
+    special_foods_eaten = 0;
+    base_score_per_food = 10;
+    
+    base_move_delay = move_delay;
+    
+    // First move is due straight away
+    last_move_time = current_time - get_level_speed(level, false);
+}
+
+void SnakeSim::save_state(SimState& state) const {
+    state.time = now();
+    state.body.resize(snake.get_length());
+    for (int i = 0; i < snake.get_length(); i++) {
+        state.body[i] = snake.get_segment(i);
+    }
+    snake.get_free_cell_order(state.free_cells);
+    state.direction = snake.direction;
+    state.next_direction = snake.next_direction;
+    state.food = food;
+    state.power_ups = power_ups;
+    state.rng_state = rng.get_state();
+    state.rng_increment = rng.get_increment();
+    for (int i = 0; i < input_count; i++) {
+        state.inputs[i] = input_queue[(input_head + i) % INPUT_QUEUE_CAPACITY];
+    }
+    state.input_count = input_count;
+    state.seed = seed;
+    state.game_over = game_over;
+    state.score = score;
+    state.level = level;
+    state.foods_needed_for_level = foods_needed_for_level;
+    state.base_score_per_food = base_score_per_food;
+    state.foods_eaten = foods_eaten;
+    state.special_foods_eaten = special_foods_eaten;
+    state.last_move_time = last_move_time;
+    state.base_move_delay = base_move_delay;
+}
+
+void SnakeSim::load_state(const SimState& state) {
+    if (!clock) default_clock.set(state.time);
+    
+    snake.restore(state.body, state.direction, state.next_direction, state.free_cells);
+    food = state.food;
+    power_ups = state.power_ups;
+    rng.set_state(state.rng_state, state.rng_increment);
+    input_head = 0;
+    input_count = std::max(0, std::min(state.input_count, INPUT_QUEUE_CAPACITY));
+    for (int i = 0; i < input_count; i++) {
+        input_queue[i] = state.inputs[i];
+    }
+    events.clear();
+    input_latency = InputLatencyStats();
+    
+    seed = state.seed;
+    game_over = state.game_over;
+    score = state.score;
+    level = state.level;
+    foods_needed_for_level = state.foods_needed_for_level;
+    base_score_per_food = state.base_score_per_food;
+    foods_eaten = state.foods_eaten;
+    special_foods_eaten = state.special_foods_eaten;
+    last_move_time = state.last_move_time;
+    base_move_delay = state.base_move_delay;
+}
+
+int SnakeSim::step(const SimInput& input) {
+    events.clear();
+    if (game_over) return 0;
+    
+    push_input(input);
+    
+    uint32_t current_time = now();
+    int moves = 0;
+    
+    // Catch up on every move that fell due since the last one, each at its
+    // own timestamp, so a late step never slows the game down
+    while (!game_over) {
+        uint32_t move_time = get_next_move_time();
+        if (static_cast<int32_t>(current_time - move_time) < 0) break;
+        
+        // A speed boost that ran out before this move stretches its delay
+        power_ups.update(move_time);
+        if (get_next_move_time() != move_time) continue;
+        
+        run_move(move_time);
+        moves++;
+    }
+    
+    // Update power-ups
+    power_ups.update(current_time);
+    
+    return moves;
+}
+
+bool SnakeSim::push_input(const SimInput& input) {
+    if (!input.turn || game_over || input_count == INPUT_QUEUE_CAPACITY) return false;
+    
+    // Validate against the direction this turn will follow, not the current one
+    Direction effective = snake.next_direction;
+    if (input_count > 0) {
+        effective = input_queue[(input_head + input_count - 1) % INPUT_QUEUE_CAPACITY].direction;
+    }
+    if (input.direction == effective || !Snake::is_valid_turn(effective, input.direction)) {
+        return false;
+    }
+    
+    QueuedInput& slot = input_queue[(input_head + input_count) % INPUT_QUEUE_CAPACITY];
+    slot.direction = input.direction;
+    slot.time = now() - std::min(input.age, now());
+    input_count++;
+    return true;
+}
+
+void SnakeSim::apply_queued_input(uint32_t move_time) {
+    if (input_count == 0) return;
+    
+    // One turn per move
+    const QueuedInput& input = input_queue[input_head];
+    input_head = (input_head + 1) % INPUT_QUEUE_CAPACITY;
+    input_count--;
+    
+    snake.change_direction(input.direction);
+    input_latency.record(move_time - input.time);
+}
+
+void SnakeSim::run_move(uint32_t move_time) {
+    apply_queued_input(move_time);
+    snake.move();
+    last_move_time = move_time;
+    
+    // Check wall collision (with phase mode support)
+    if (snake.check_collision(power_ups.is_phase_active())) {
+        game_over = true;
+        const Segment& head = snake.get_head();
+        emit(SIM_EVENT_GAME_OVER, food.type, head.x, head.y, score);
+        return;
+    }
+    
+    // Check collision with food
+    if (food.check_collision(snake)) {
+        emit(SIM_EVENT_FOOD_EATEN, food.type, food.x, food.y, score);
+        
+        // Apply food effect
+        apply_food_effect(food.type, move_time);
+        
+        // Spawn new food (stays inactive once the board is full)
+        food.spawn(snake, move_time, rng);
+        food.type = food.get_random_type(level, foods_eaten, rng);
+        
+        foods_eaten++;
+        
+        // Check if level up
+        if (foods_eaten >= foods_needed_for_level) {
+            level_up();
+        }
+    }
+}
+
+void SnakeSim::emit(SimEventType type, FoodType food_type, int x, int y, int value) {
+    SimEvent event;
+    event.type = type;
+    event.time = last_move_time;
+    event.food_type = food_type;
+    event.x = x;
+    event.y = y;
+    event.value = value;
+    events.push_back(event);
+}
+
+void SnakeSim::apply_food_effect(FoodType type, uint32_t current_time) {
+    // Update combo system
+    power_ups.combo_count++;
+    power_ups.combo_multiplier = 1 + (power_ups.combo_count / 3); // Increase every 3 foods
+    power_ups.last_food_time = current_time;
+    
+    int base_points = base_score_per_food;
+    int multiplier = power_ups.get_score_multiplier();
+    
+    switch (type) {
+        case FOOD_NORMAL:
+            snake.grow();
+            score += base_points * multiplier;
+            break;
+            
+        case FOOD_SPEED:
+            snake.grow();
+            score += (base_points + 5) * multiplier;
+            power_ups.speed_boost = true;
+            power_ups.speed_end_time = current_time + 5000; // 5 seconds
+            special_foods_eaten++;
+            break;
+            
+        case FOOD_DOUBLE:
+            snake.grow();
+            score += base_points * multiplier;
+            power_ups.double_score = true;
+            power_ups.double_score_end_time = current_time + 8000; // 8 seconds
+            special_foods_eaten++;
+            break;
+            
+        case FOOD_GOLDEN:
+            snake.grow();
+            score += (base_points * 3) * multiplier;
+            special_foods_eaten++;
+            break;
+            
+        case FOOD_SHRINK:
+            snake.shrink(2);
+            score += (base_points / 2) * multiplier;
+            special_foods_eaten++;
+            break;
+            
+        case FOOD_PHASE:
+            snake.grow();
+            score += (base_points + 10) * multiplier;
+            power_ups.phase_through_walls = true;
+            power_ups.phase_end_time = current_time + 6000; // 6 seconds
+            special_foods_eaten++;
+            break;
+            
+        case FOOD_MEGA:
+            snake.grow();
+            score += (base_points * 5) * multiplier;
+            special_foods_eaten++;
+            break;
+            
+        default:
+            break;
+    }
+}
+
+void SnakeSim::level_up() {
+    level++;
+    foods_needed_for_level = get_level_required_foods(level);
+    foods_eaten = 0;
+    
+    // Increase base score per food
+    base_score_per_food += 2;
+    
+    const Segment& head = snake.get_head();
+    emit(SIM_EVENT_LEVEL_UP, food.type, head.x, head.y, level);
+}
+
+void InputLatencyStats::record(uint32_t latency) {
+    last = latency;
+    max = std::max(max, latency);
+    total += latency;
+    count++;
+}
+
+uint32_t SnakeSim::get_level_speed(int level, bool speed_boost) const {
+    // Signed math so high levels clamp to the minimum instead of wrapping
+    int delay = static_cast<int>(base_move_delay) - (level - 1) * 10;
+    uint32_t speed = static_cast<uint32_t>(std::max(delay, 50)); // Minimum delay
+    
+    if (speed_boost) {
+        speed = speed * 0.6f; // 40% faster
+    }
+    
+    return speed;
+}
+
+int SnakeSim::get_level_required_foods(int level) const {
+    return 5 + (level - 1) * 2; // 5, 7, 9, 11, ...
+}
+
+uint32_t SnakeSim::get_next_move_time() const {
+    return last_move_time + get_level_speed(level, power_ups.is_speed_active());
+}
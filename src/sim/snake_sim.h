@@ -0,0 +1,197 @@
+#ifndef SNAKE_SIM_H
+#define SNAKE_SIM_H
+
+#include "sim_types.h"
+#include "snake.h"
+#include "food.h"
+#include "powerups.h"
+#include "prng.h"
+#include <vector>
+
+// Time source for the simulation, in milliseconds.
+// The game injects the SDL tick counter; bots, soak tests and replays
+// drive a ManualClock so the rules run as fast as the CPU allows.
+class SimClock {
+public:
+    virtual ~SimClock() {}
+    virtual uint32_t now() const = 0;
+};
+
+class ManualClock : public SimClock {
+private:
+    uint32_t current;
+    
+public:
+    ManualClock() : current(0) {}
+    uint32_t now() const override { return current; }
+    void set(uint32_t time) { current = time; }
+    void advance(uint32_t delta) { current += delta; }
+};
+
+// PCG stream ids, so gameplay and cosmetic generators never overlap
+const uint64_t SIM_RNG_STREAM = 1;
+const uint64_t EFFECTS_RNG_STREAM = 2;
+
+// Things that happened during a step, for the presenter to react to
+// (sounds, particles, screen shake, persistence)
+enum SimEventType {
+    SIM_EVENT_FOOD_EATEN,   // food_type eaten at (x, y)
+    SIM_EVENT_LEVEL_UP,     // value = new level
+    SIM_EVENT_GAME_OVER     // snake hit a wall or itself
+};
+
+struct SimEvent {
+    SimEventType type;
+    uint32_t time;          // Simulation time of the move that caused it
+    FoodType food_type;
+    int x, y;
+    int value;
+};
+
+// Player input for one step. age is how long ago the key was pressed, in
+// ms, when the input only reaches the simulation later (through SimThread's
+// command queue); it counts towards the input latency.
+struct SimInput {
+    bool turn;
+    Direction direction;
+    uint32_t age;
+    
+    SimInput() : turn(false), direction(DIR_RIGHT), age(0) {}
+    explicit SimInput(Direction dir, uint32_t pressed_ms_ago = 0)
+        : turn(true), direction(dir), age(pressed_ms_ago) {}
+};
+
+// Direction presses wait here until the move that applies them, so two
+// quick turns inside one move interval are both kept
+const int INPUT_QUEUE_CAPACITY = 4;
+
+struct QueuedInput {
+    Direction direction;
+    uint32_t time;          // Simulation time of the press
+};
+
+// Input-to-move latency (press until the move that applies it), in ms
+struct InputLatencyStats {
+    uint32_t last;
+    uint32_t max;
+    uint64_t total;
+    uint32_t count;
+    
+    InputLatencyStats() : last(0), max(0), total(0), count(0) {}
+    void record(uint32_t latency);
+    float get_average() const { return count ? static_cast<float>(total) / count : 0.0f; }
+};
+
+// Everything the rules depend on, for replay keyframes. Input latency
+// stats and pending events are not part of it.
+struct SimState {
+    uint32_t time;
+    std::vector<Segment> body;      // Head first
+    std::vector<int> free_cells;    // Free cells in slot order, so food keeps spawning where it would
+    Direction direction;
+    Direction next_direction;
+    Food food;
+    PowerUps power_ups;
+    uint64_t rng_state;
+    uint64_t rng_increment;
+    QueuedInput inputs[INPUT_QUEUE_CAPACITY];  // Oldest first
+    int input_count;
+    uint64_t seed;
+    bool game_over;
+    int score;
+    int level;
+    int foods_needed_for_level;
+    int base_score_per_food;
+    int foods_eaten;
+    int special_foods_eaten;
+    uint32_t last_move_time;
+    uint32_t base_move_delay;
+};
+
+// Headless game rules: movement timing, collision, eating, combo and level-up.
+// Has no SDL dependency so it can be linked into tools as libsnakesim.
+class SnakeSim {
+private:
+    const SimClock* clock;
+    ManualClock default_clock;
+    
+    Snake snake;
+    Food food;
+    PowerUps power_ups;
+    std::vector<SimEvent> events;
+    
+    QueuedInput input_queue[INPUT_QUEUE_CAPACITY];
+    int input_head;
+    int input_count;
+    InputLatencyStats input_latency;
+    
+    // Gameplay randomness only; cosmetic effects use their own stream
+    Prng rng;
+    uint64_t seed;
+    
+    bool game_over;
+    int score;
+    int level;
+    int foods_needed_for_level;
+    int base_score_per_food;
+    int foods_eaten;
+    int special_foods_eaten;
+    
+    uint32_t last_move_time;
+    uint32_t base_move_delay;
+    
+    uint32_t now() const { return clock ? clock->now() : default_clock.now(); }
+    void run_move(uint32_t move_time);
+    void apply_queued_input(uint32_t move_time);
+    void emit(SimEventType type, FoodType food_type, int x, int y, int value);
+    void apply_food_effect(FoodType type, uint32_t current_time);
+    void level_up();
+    
+public:
+    SnakeSim();
+    
+    // The clock must outlive the simulation; nullptr selects the built-in ManualClock
+    void set_clock(const SimClock* sim_clock) { clock = sim_clock; }
+    ManualClock& get_manual_clock() { return default_clock; }
+    
+    // Start a new game; the same seed and inputs always replay the same game
+    void reset(uint32_t move_delay, uint64_t game_seed);
+    
+    // Copies the full state out; a game loaded from it continues exactly
+    // like the one it was saved from
+    void save_state(SimState& state) const;
+    
+    // Resumes from a saved state; the built-in clock is set to its time
+    void load_state(const SimState& state);
+    
+    // Queue a turn for the next free move. Rejected (returns false) when the
+    // queue is full or the turn reverses, or repeats, the direction that will
+    // be in effect by then.
+    bool push_input(const SimInput& input);
+    
+    // Queue input, then advance the rules to the current clock time, running
+    // every move that is due. Returns the number of moves made; events are
+    // valid until the next step.
+    int step(const SimInput& input);
+    
+    uint32_t get_level_speed(int level, bool speed_boost) const;
+    int get_level_required_foods(int level) const;
+    uint32_t get_next_move_time() const;
+    uint32_t get_last_move_time() const { return last_move_time; }
+    
+    const std::vector<SimEvent>& get_events() const { return events; }
+    const Snake& get_snake() const { return snake; }
+    const Food& get_food() const { return food; }
+    const PowerUps& get_power_ups() const { return power_ups; }
+    bool is_game_over() const { return game_over; }
+    uint64_t get_seed() const { return seed; }
+    uint32_t get_time() const { return now(); }
+    const InputLatencyStats& get_input_latency() const { return input_latency; }
+    int get_score() const { return score; }
+    int get_level() const { return level; }
+    int get_foods_eaten() const { return foods_eaten; }
+    int get_foods_needed_for_level() const { return foods_needed_for_level; }
+    int get_special_foods_eaten() const { return special_foods_eaten; }
+};
+
+#endif // SNAKE_SIM_H
@@ -0,0 +1,39 @@
+#ifndef SIM_SPSC_QUEUE_H
+#define SIM_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Capacity must be a power of two; push() fails instead of blocking
+// when the queue is full.
+template <typename T, size_t Capacity>
+class SpscQueue {
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+    
+    T items[Capacity];
+    alignas(64) std::atomic<size_t> head;  // Next slot to read, advanced by the consumer
+    alignas(64) std::atomic<size_t> tail;  // Next slot to write, advanced by the producer
+    
+public:
+    SpscQueue() : head(0), tail(0) {}
+    
+    bool push(const T& item) {
+        size_t write = tail.load(std::memory_order_relaxed);
+        if (write - head.load(std::memory_order_acquire) == Capacity) return false;
+        items[write & (Capacity - 1)] = item;
+        tail.store(write + 1, std::memory_order_release);
+        return true;
+    }
+    
+    bool pop(T& item) {
+        size_t read = head.load(std::memory_order_relaxed);
+        if (read == tail.load(std::memory_order_acquire)) return false;
+        item = items[read & (Capacity - 1)];
+        head.store(read + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif // SIM_SPSC_QUEUE_H
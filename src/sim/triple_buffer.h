@@ -0,0 +1,40 @@
+#ifndef SIM_TRIPLE_BUFFER_H
+#define SIM_TRIPLE_BUFFER_H
+
+#include <atomic>
+
+// Lock-free single-writer, single-reader triple buffer.
+// The writer fills the back slot and publishes it; the reader picks up the
+// newest published slot whenever it likes. Neither side ever waits: the
+// writer may publish several times between reads (older values are simply
+// dropped) and the reader keeps its slot until it asks for a newer one.
+template <typename T>
+class TripleBuffer {
+private:
+    static const int INDEX_MASK = 3;
+    static const int FRESH_BIT = 4;  // Set while the middle slot holds an unread value
+    
+    T slots[3];
+    std::atomic<int> middle;         // Slot index in flight between the two sides
+    int back;                        // Owned by the writer
+    int front;                       // Owned by the reader
+    
+public:
+    TripleBuffer() : middle(1), back(0), front(2) {}
+    
+    // Writer side: fill get_back(), then publish() it
+    T& get_back() { return slots[back]; }
+    void publish() {
+        back = middle.exchange(back | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+    
+    // Reader side: swaps in the newest published value, false if none is new
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH_BIT)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& get_front() const { return slots[front]; }
+};
+
+#endif // SIM_TRIPLE_BUFFER_H
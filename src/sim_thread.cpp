@@ -0,0 +1,256 @@
+#include "sim_thread.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+// Stop sleeping this close to a move and wait on the high-resolution counter
+static const int32_t MOVE_SPIN_MS = 2;
+
+SimThread::SimThread(uint32_t tick_ms, uint32_t max_catch_up_ms)
+    : quit(false), acknowledged_event_seq(0), thread(nullptr),
+      tick_ms(tick_ms), max_catch_up_ms(max_catch_up_ms),
+      ticking(false), generation(0), next_event_seq(0), pending_first_seq(0),
+      replay_writer(nullptr), replay_written(0), requested_generation(0), dropped_commands(0) {
+    pending_events.reserve(16);
+    body_before_move.reserve(GRID_WIDTH * GRID_HEIGHT);
+    body_scratch.reserve(GRID_WIDTH * GRID_HEIGHT);
+}
+
+SimThread::~SimThread() {
+    stop();
+}
+
+bool SimThread::start() {
+    if (thread) return true;
+    
+    quit.store(false);
+    thread = SDL_CreateThread(thread_main, "simulation", this);
+    return thread != nullptr;
+}
+
+void SimThread::stop() {
+    if (!thread) return;
+    
+    quit.store(true);
+    SDL_WaitThread(thread, nullptr);
+    thread = nullptr;
+}
+
+void SimThread::set_replay_output(SaveWriter* writer, const std::string& dir) {
+    replay_writer = writer;
+    replay_dir = dir;
+}
+
+bool SimThread::reset(uint32_t move_delay, uint64_t seed) {
+    SimCommand command = {SIM_COMMAND_RESET, DIR_RIGHT, move_delay, seed, ++requested_generation, 0};
+    return send(command);
+}
+
+bool SimThread::set_running(bool running) {
+    SimCommand command = {running ? SIM_COMMAND_RUN : SIM_COMMAND_PAUSE, DIR_RIGHT, 0, 0, 0, 0};
+    return send(command);
+}
+
+bool SimThread::push_turn(Direction direction, Uint32 pressed_at) {
+    SimCommand command = {SIM_COMMAND_TURN, direction, 0, 0, 0, pressed_at};
+    return send(command);
+}
+
+bool SimThread::send(const SimCommand& command) {
+    if (commands.push(command)) return true;
+    
+    // A late turn is worthless, but a lost reset or pause leaves the game
+    // out of step with the screen; the thread drains the queue every tick
+    if (command.type != SIM_COMMAND_TURN) {
+        Uint32 start = SDL_GetTicks();
+        while (thread && SDL_GetTicks() - start < SIM_COMMAND_RETRY_MS) {
+            SDL_Delay(1);
+            if (commands.push(command)) return true;
+        }
+    }
+    
+    dropped_commands++;
+    std::cerr << "Warning: simulation command queue full, dropped a "
+              << (command.type == SIM_COMMAND_TURN ? "turn" : "game command")
+              << " (" << dropped_commands << " so far)" << std::endl;
+    return false;
+}
+
+bool SimThread::wait_for_reset(uint32_t timeout_ms) {
+    Uint32 start = SDL_GetTicks();
+    while (true) {
+        acquire();
+        if (get_snapshot().generation == requested_generation) return true;
+        if (!thread || SDL_GetTicks() - start >= timeout_ms) return false;
+        SDL_Delay(0);
+    }
+}
+
+int SimThread::thread_main(void* data) {
+    static_cast<SimThread*>(data)->loop();
+    return 0;
+}
+
+bool SimThread::apply_commands(Uint64& next_tick) {
+    bool changed = false;
+    SimCommand command;
+    while (commands.pop(command)) {
+        switch (command.type) {
+            case SIM_COMMAND_RESET:
+                save_replay();  // A game abandoned for a new one is still kept
+                sim.get_manual_clock().set(0);
+                sim.reset(command.move_delay, command.seed);
+                begin_replay(command.seed, command.move_delay);
+                generation = command.generation;
+                pending_events.clear();
+                pending_first_seq = next_event_seq;
+                tick_timing = TickTimingStats();
+                copy_body(body_before_move);
+                ticking = true;
+                next_tick = SDL_GetPerformanceCounter();
+                changed = true;
+                break;
+            case SIM_COMMAND_RUN:
+                // Ticks restart from now; paused time is never caught up
+                if (!ticking) next_tick = SDL_GetPerformanceCounter();
+                ticking = true;
+                changed = true;
+                break;
+            case SIM_COMMAND_PAUSE:
+                ticking = false;
+                changed = true;
+                break;
+            case SIM_COMMAND_TURN: {
+                // Latency runs from the key press, event pump and queue included
+                int32_t age = static_cast<int32_t>(SDL_GetTicks() - command.pressed_at);
+                SimInput input(command.direction, static_cast<uint32_t>(std::max(age, 0)));
+                
+                // Only accepted turns change the game, so only they are recorded
+                if (sim.push_input(input)) {
+                    replay.record_input(sim.get_time(), command.direction);
+                }
+                break;
+            }
+        }
+    }
+    return changed;
+}
+
+void SimThread::loop() {
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 tick_duration = std::max<Uint64>(1, frequency * tick_ms / 1000);
+    const Uint64 max_catch_up = frequency * max_catch_up_ms / 1000;
+    const uint32_t tick_us = tick_ms * 1000;
+    
+    Uint64 next_tick = SDL_GetPerformanceCounter();
+    
+    while (!quit.load(std::memory_order_acquire)) {
+        bool changed = apply_commands(next_tick);
+        
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (ticking) {
+            // Drop time beyond the catch-up limit after a stall
+            if (now > next_tick && now - next_tick > max_catch_up) {
+                next_tick = now - max_catch_up;
+            }
+            
+            while (ticking && now >= next_tick) {
+                sim.get_manual_clock().advance(tick_ms);
+                
+                // Keep the body from before a move for the renderer to slide from
+                bool move_due = static_cast<int32_t>(sim.get_time() - sim.get_next_move_time()) >= 0;
+                if (move_due) copy_body(body_scratch);
+                
+                if (sim.step(SimInput()) > 0) {
+                    Uint64 lag = (now - next_tick) * 1000000 / frequency;
+                    tick_timing.record(static_cast<uint32_t>(std::min<Uint64>(lag, UINT32_MAX)), tick_us);
+                    if (move_due) body_before_move.swap(body_scratch);
+                }
+                for (const SimEvent& event : sim.get_events()) {
+                    pending_events.push_back(event);
+                    next_event_seq++;
+                }
+                if (replay.after_step(sim)) append_replay();
+                next_tick += tick_duration;
+                changed = true;
+                
+                if (sim.is_game_over()) {
+                    ticking = false;
+                    save_replay();
+                }
+            }
+        }
+        
+        if (changed) publish();
+        
+        // Ticks between moves only advance timers, so they are caught up
+        // after a coarse sleep; the ticks leading into a move run on time
+        int32_t until_move = static_cast<int32_t>(sim.get_next_move_time() - sim.get_time());
+        if (!ticking || until_move > MOVE_SPIN_MS) {
+            SDL_Delay(1);
+        } else if (SDL_GetPerformanceCounter() < next_tick) {
+            SDL_Delay(0);
+        }
+    }
+    
+    save_replay();
+}
+
+void SimThread::publish() {
+    // Forget events the reader has already handled
+    uint32_t acknowledged = acknowledged_event_seq.load(std::memory_order_acquire);
+    size_t handled = 0;
+    while (handled < pending_events.size() &&
+           static_cast<int32_t>(pending_first_seq + handled - acknowledged) < 0) {
+        handled++;
+    }
+    if (handled > 0) {
+        pending_events.erase(pending_events.begin(), pending_events.begin() + handled);
+        pending_first_seq += static_cast<uint32_t>(handled);
+    }
+    
+    SimSnapshot& snapshot = snapshots.get_back();
+    snapshot.capture(sim, body_before_move);
+    snapshot.generation = generation;
+    snapshot.running = ticking;
+    snapshot.published_at = SDL_GetPerformanceCounter();
+    snapshot.tick_timing = tick_timing;
+    snapshot.events.assign(pending_events.begin(), pending_events.end());
+    snapshot.first_event_seq = pending_first_seq;
+    snapshots.publish();
+}
+
+void SimThread::begin_replay(uint64_t seed, uint32_t move_delay) {
+    if (!replay_writer) return;
+    
+    replay.begin(seed, move_delay, tick_ms);
+    char name[32];
+    std::snprintf(name, sizeof(name), "replay_%016llx.snkr", static_cast<unsigned long long>(seed));
+    replay_path = replay_dir + name;
+    replay_writer->write(replay_path, replay.get_data());
+    replay_written = replay.get_data().size();
+}
+
+// Hands over whatever the recorder added since the last call
+void SimThread::append_replay() {
+    const std::string& data = replay.get_data();
+    if (data.size() <= replay_written) return;
+    
+    replay_writer->append(replay_path, data.substr(replay_written));
+    replay_written = data.size();
+}
+
+void SimThread::save_replay() {
+    if (!replay.is_recording()) return;
+    
+    replay.finish(sim);
+    append_replay();
+}
+
+void SimThread::copy_body(std::vector<Segment>& body) const {
+    const Snake& snake = sim.get_snake();
+    body.resize(snake.get_length());
+    for (int i = 0; i < snake.get_length(); i++) {
+        body[i] = snake.get_segment(i);
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "sim/snake_sim.h"
+#include "sim/sim_snapshot.h"
+#include "sim/triple_buffer.h"
+#include "sim/spsc_queue.h"
+#include "sim/replay.h"
+#include "save_writer.h"
+
+// Requests from the main thread, applied by the simulation thread in order
+enum SimCommandType {
+    SIM_COMMAND_RESET,      // New game with move_delay and seed, then run
+    SIM_COMMAND_RUN,
+    SIM_COMMAND_PAUSE,
+    SIM_COMMAND_TURN
+};
+
+struct SimCommand {
+    SimCommandType type;
+    Direction direction;
+    uint32_t move_delay;
+    uint64_t seed;
+    uint32_t generation;
+    Uint32 pressed_at;      // SDL_GetTicks() of the key press behind a turn
+};
+
+const size_t SIM_COMMAND_QUEUE_CAPACITY = 64;
+const uint32_t SIM_COMMAND_RETRY_MS = 1000;   // How long a full queue may hold up anything but a turn
+
+// Runs SnakeSim on its own thread at the fixed SIM_TICK_MS rate, so a slow
+// frame never delays a move. The main thread sends commands through a
+// lock-free queue and reads the newest SimSnapshot from a triple buffer;
+// the two sides share no locks. Everything except the public methods below
+// belongs to the simulation thread once start() has returned.
+class SimThread {
+private:
+    SnakeSim sim;
+    TripleBuffer<SimSnapshot> snapshots;
+    SpscQueue<SimCommand, SIM_COMMAND_QUEUE_CAPACITY> commands;
+    std::atomic<bool> quit;
+    std::atomic<uint32_t> acknowledged_event_seq;  // Every event before this has been handled
+    SDL_Thread* thread;
+    uint32_t tick_ms;
+    uint32_t max_catch_up_ms;
+    
+    // Simulation thread state
+    bool ticking;
+    uint32_t generation;
+    uint32_t next_event_seq;
+    std::vector<SimEvent> pending_events;   // Published but not yet acknowledged
+    uint32_t pending_first_seq;
+    TickTimingStats tick_timing;
+    std::vector<Segment> body_before_move;  // Published with each snapshot for interpolation
+    std::vector<Segment> body_scratch;
+    ReplayRecorder replay;
+    SaveWriter* replay_writer;
+    std::string replay_dir;
+    std::string replay_path;                // File of the game being recorded
+    size_t replay_written;                  // Bytes of it already handed to replay_writer
+    
+    // Main thread state
+    uint32_t requested_generation;
+    uint32_t dropped_commands;
+    
+    static int thread_main(void* data);
+    bool send(const SimCommand& command);
+    void loop();
+    bool apply_commands(Uint64& next_tick);
+    void publish();
+    void copy_body(std::vector<Segment>& body) const;
+    void begin_replay(uint64_t seed, uint32_t move_delay);
+    void append_replay();
+    void save_replay();
+    
+public:
+    SimThread(uint32_t tick_ms, uint32_t max_catch_up_ms);
+    ~SimThread();
+    
+    bool start();
+    void stop();
+    
+    // Before start(): record every game to a file under dir named after its
+    // seed, written through writer as it is played: the header at reset,
+    // each keyframe as it is taken and the rest at game over. A crash loses
+    // at most the last keyframe interval. nullptr turns recording off.
+    void set_replay_output(SaveWriter* writer, const std::string& dir);
+    
+    // Main thread: commands, false when the queue stayed full. A turn is
+    // dropped at once; the others wait up to SIM_COMMAND_RETRY_MS for room.
+    bool reset(uint32_t move_delay, uint64_t seed);
+    bool set_running(bool running);
+    bool push_turn(Direction direction, Uint32 pressed_at);
+    
+    // Main thread: picks up the newest snapshot, true if it changed
+    bool acquire() { return snapshots.acquire(); }
+    const SimSnapshot& get_snapshot() const { return snapshots.get_front(); }
+    
+    // Blocks until a snapshot of the latest reset() arrives, so the first
+    // frame of a new game never shows the previous one
+    bool wait_for_reset(uint32_t timeout_ms);
+    uint32_t get_generation() const { return requested_generation; }
+    
+    // Events with sequence numbers below seq are dropped from later snapshots
+    void acknowledge_events(uint32_t seq) { acknowledged_event_seq.store(seq, std::memory_order_release); }
+};
+
+#endif // SIM_THREAD_H
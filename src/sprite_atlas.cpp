@@ -0,0 +1,183 @@
+#include "sprite_atlas.h"
+#include <SDL2/SDL_image.h>
+#include <iostream>
+
+// Cells are stored larger than the HUD draws them so linear filtering has
+// detail to work with; the source art is ~400 px tall
+static const int SPRITE_CELL_HEIGHT = 48;
+static const int ATLAS_WIDTH = 512;
+static const int SPRITE_PADDING = 2;
+
+// Area-averaging downscale of an ARGB8888 surface to the given height.
+// Colour is weighted by alpha so transparent edges do not darken the outline.
+static SDL_Surface* downsample(SDL_Surface* source, int height) {
+    int width = (source->w * height + source->h / 2) / source->h;
+    if (width < 1) width = 1;
+    
+    SDL_Surface* result = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!result) return nullptr;
+    
+    SDL_LockSurface(source);
+    SDL_LockSurface(result);
+    for (int y = 0; y < height; y++) {
+        int y0 = y * source->h / height;
+        int y1 = (y + 1) * source->h / height;
+        if (y1 <= y0) y1 = y0 + 1;
+        
+        Uint32* out = reinterpret_cast<Uint32*>(static_cast<Uint8*>(result->pixels) + y * result->pitch);
+        for (int x = 0; x < width; x++) {
+            int x0 = x * source->w / width;
+            int x1 = (x + 1) * source->w / width;
+            if (x1 <= x0) x1 = x0 + 1;
+            
+            Uint32 sum_a = 0, sum_r = 0, sum_g = 0, sum_b = 0;
+            for (int sy = y0; sy < y1; sy++) {
+                const Uint32* row = reinterpret_cast<const Uint32*>(
+                    static_cast<const Uint8*>(source->pixels) + sy * source->pitch);
+                for (int sx = x0; sx < x1; sx++) {
+                    Uint32 p = row[sx];
+                    Uint32 a = p >> 24;
+                    sum_a += a;
+                    sum_r += ((p >> 16) & 0xFF) * a;
+                    sum_g += ((p >> 8) & 0xFF) * a;
+                    sum_b += (p & 0xFF) * a;
+                }
+            }
+            
+            Uint32 count = static_cast<Uint32>((y1 - y0) * (x1 - x0));
+            Uint32 a = sum_a / count;
+            Uint32 r = sum_a ? sum_r / sum_a : 0;
+            Uint32 g = sum_a ? sum_g / sum_a : 0;
+            Uint32 b = sum_a ? sum_b / sum_a : 0;
+            out[x] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+    SDL_UnlockSurface(result);
+    SDL_UnlockSurface(source);
+    return result;
+}
+
+SpriteAtlas::SpriteAtlas(SDL_Renderer* renderer) : renderer(renderer), texture(nullptr) {
+    for (int i = 0; i < 128; i++) {
+        sprites[i].src = {0, 0, 0, 0};
+    }
+}
+
+SpriteAtlas::~SpriteAtlas() {
+    for (auto& entry : pending) {
+        SDL_FreeSurface(entry.second);
+    }
+    if (texture) SDL_DestroyTexture(texture);
+}
+
+bool SpriteAtlas::add_image(char c, const std::string& path) {
+    return add_cell(c, load_cell(path));
+}
+
+SDL_Surface* SpriteAtlas::load_cell(const std::string& path) {
+    SDL_Surface* loaded = IMG_Load(path.c_str());
+    if (!loaded) return nullptr;
+    
+    SDL_Surface* cell = make_cell(loaded);
+    SDL_FreeSurface(loaded);
+    return cell;
+}
+
+SDL_Surface* SpriteAtlas::make_cell(SDL_Surface* image) {
+    if (!image || image->h <= 0) return nullptr;
+    if (image->format->format == SDL_PIXELFORMAT_ARGB8888) {
+        return downsample(image, SPRITE_CELL_HEIGHT);
+    }
+    
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!converted) return nullptr;
+    
+    SDL_Surface* cell = downsample(converted, SPRITE_CELL_HEIGHT);
+    SDL_FreeSurface(converted);
+    return cell;
+}
+
+bool SpriteAtlas::add_cell(char c, SDL_Surface* cell) {
+    if (!cell) return false;
+    if (c <= 0) {
+        SDL_FreeSurface(cell);
+        return false;
+    }
+    
+    pending.push_back(std::make_pair(c, cell));
+    return true;
+}
+
+bool SpriteAtlas::pack() {
+    if (pending.empty()) return false;
+    
+    // Shelf layout; every cell has the same height so shelves are uniform
+    std::vector<SDL_Rect> placements;
+    int shelf_x = 0, shelf_y = 0;
+    for (auto& entry : pending) {
+        SDL_Surface* cell = entry.second;
+        if (shelf_x > 0 && shelf_x + cell->w > ATLAS_WIDTH) {
+            shelf_x = 0;
+            shelf_y += SPRITE_CELL_HEIGHT + SPRITE_PADDING;
+        }
+        placements.push_back({shelf_x, shelf_y, cell->w, cell->h});
+        shelf_x += cell->w + SPRITE_PADDING;
+    }
+    int atlas_height = shelf_y + SPRITE_CELL_HEIGHT;
+    
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, atlas_height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (sheet) {
+        for (size_t i = 0; i < pending.size(); i++) {
+            SDL_SetSurfaceBlendMode(pending[i].second, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(pending[i].second, nullptr, sheet, &placements[i]);
+        }
+        texture = SDL_CreateTextureFromSurface(renderer, sheet);
+        SDL_FreeSurface(sheet);
+    }
+    
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        for (size_t i = 0; i < pending.size(); i++) {
+            sprites[static_cast<int>(pending[i].first)].src = placements[i];
+        }
+    } else {
+        std::cerr << "Warning: Could not create sprite atlas: " << SDL_GetError() << std::endl;
+    }
+    
+    for (auto& entry : pending) {
+        SDL_FreeSurface(entry.second);
+    }
+    pending.clear();
+    return texture != nullptr;
+}
+
+const SpriteAtlas::Sprite* SpriteAtlas::get_sprite(char c) const {
+    if (c <= 0 || !texture) return nullptr;
+    const Sprite* sprite = &sprites[static_cast<int>(c)];
+    return sprite->src.w > 0 ? sprite : nullptr;
+}
+
+int SpriteAtlas::measure(const std::string& text, int height) const {
+    int width = 0;
+    for (char c : text) {
+        const Sprite* sprite = get_sprite(c);
+        width += sprite ? sprite->src.w * height / SPRITE_CELL_HEIGHT : height / 2;
+    }
+    return width;
+}
+
+int SpriteAtlas::draw(RenderBatch& batch, const std::string& text, int x, int y, int height, SDL_Color color) const {
+    int pen_x = x;
+    for (char c : text) {
+        const Sprite* sprite = get_sprite(c);
+        if (!sprite) {
+            pen_x += height / 2;
+            continue;
+        }
+        int width = sprite->src.w * height / SPRITE_CELL_HEIGHT;
+        SDL_Rect dest = {pen_x, y, width, height};
+        batch.copy(texture, &sprite->src, &dest, color);
+        pen_x += width;
+    }
+    return pen_x - x;
+}
@@ -0,0 +1,58 @@
+#ifndef SPRITE_ATLAS_H
+#define SPRITE_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+#include "render_batch.h"
+
+// Character sprites (the snake digits and letters under data/texture) packed
+// into a single texture at load time. Each image is box-filtered down to a
+// common cell height once, so the HUD counters that change every tick are
+// plain textured quads on the RenderBatch and never touch font rasterization.
+class SpriteAtlas {
+private:
+    struct Sprite {
+        SDL_Rect src;      // Location in the atlas texture, w == 0 when missing
+    };
+    
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    Sprite sprites[128];   // Indexed by ASCII character
+    
+    // Images loaded by add_image() and waiting for pack()
+    std::vector<std::pair<char, SDL_Surface*> > pending;
+    
+    const Sprite* get_sprite(char c) const;
+
+public:
+    explicit SpriteAtlas(SDL_Renderer* renderer);
+    ~SpriteAtlas();
+    
+    // Loads and downsamples one image for character c; false if it cannot be read
+    bool add_image(char c, const std::string& path);
+    
+    // The two halves of add_image(): load_cell() touches no shared state and
+    // may run on a loader thread, add_cell() takes ownership of its result.
+    // make_cell() downsamples an already decoded image, which it leaves alone.
+    static SDL_Surface* load_cell(const std::string& path);
+    static SDL_Surface* make_cell(SDL_Surface* image);
+    bool add_cell(char c, SDL_Surface* cell);
+    
+    // Packs every added image into the atlas texture and frees the surfaces
+    bool pack();
+    
+    bool is_loaded() const { return texture != nullptr; }
+    bool has(char c) const { return get_sprite(c) != nullptr; }
+    
+    // Width of text drawn at the given height; characters without a sprite
+    // take half a cell, like a space
+    int measure(const std::string& text, int height) const;
+    
+    // Draws text with its top-left corner at (x, y), scaled to height pixels,
+    // the sprites tinted by color; returns the width drawn
+    int draw(RenderBatch& batch, const std::string& text, int x, int y, int height, SDL_Color color) const;
+};
+
+#endif // SPRITE_ATLAS_H
@@ -0,0 +1,313 @@
+#include "stats_journal.h"
+#include "achievements.h"
+#include "save_writer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <unistd.h>
+
+static const char JOURNAL_MAGIC[8] = {'S', 'N', 'K', 'J', 'R', 'N', '1', '\0'};
+static const char SNAPSHOT_MAGIC[8] = {'S', 'N', 'K', 'S', 'N', 'P', '1', '\0'};
+static const size_t JOURNAL_HEADER_SIZE = 12;
+static const size_t RECORD_OVERHEAD = 6;       // Type, size and CRC
+
+// CRC-32 (IEEE), table built on first use
+static uint32_t crc32(const unsigned char* data, size_t size) {
+    static uint32_t table[256];
+    static bool table_ready = false;
+    if (!table_ready) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        table_ready = true;
+    }
+    
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static uint32_t crc32(const std::string& bytes) {
+    return crc32(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+}
+
+static void put_u32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static void put_u64(std::string& out, uint64_t value) {
+    put_u32(out, static_cast<uint32_t>(value));
+    put_u32(out, static_cast<uint32_t>(value >> 32));
+}
+
+// Little-endian reader over bytes[start, end); reads past the end fail
+struct ByteReader {
+    const unsigned char* data;
+    size_t size;
+    size_t pos;
+    bool ok;
+    
+    ByteReader(const std::string& bytes, size_t start, size_t end = std::string::npos)
+        : data(reinterpret_cast<const unsigned char*>(bytes.data())),
+          size(std::min(end, bytes.size())), pos(start), ok(start <= size) {}
+    
+    uint32_t u32() {
+        if (!ok || size - pos < 4) { ok = false; return 0; }
+        uint32_t value = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16) |
+                         (static_cast<uint32_t>(data[pos + 3]) << 24);
+        pos += 4;
+        return value;
+    }
+    uint64_t u64() {
+        uint64_t low = u32();
+        return low | (static_cast<uint64_t>(u32()) << 32);
+    }
+};
+
+static bool read_file(const char* path, std::string& bytes) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static void apply_record(unsigned char type, ByteReader& payload, GameStats& stats, std::vector<uint32_t>& unlocked) {
+    switch (type) {
+        case JOURNAL_GAME: {
+            GameRecord record;
+            record.score = payload.u32();
+            record.level = payload.u32();
+            record.length = payload.u32();
+            record.foods_eaten = payload.u32();
+            record.special_foods = payload.u32();
+            record.max_combo = payload.u32();
+            record.duration_ms = payload.u32();
+            if (payload.ok) stats.apply_game(record);
+            break;
+        }
+        case JOURNAL_UNLOCK: {
+            uint32_t id = payload.u32();
+            if (payload.ok) unlocked.push_back(id);
+            break;
+        }
+        case JOURNAL_RESET:
+            stats.clear();  // Like GameStats::reset_stats(), which leaves achievements alone
+            break;
+        default:
+            break;  // From a newer version; skipped, its CRC already checked
+    }
+}
+
+// Snapshot contents into stats and unlocked; returns the journal size it covers
+static bool load_snapshot(GameStats& stats, std::vector<uint32_t>& unlocked, uint64_t& covered) {
+    std::string bytes;
+    if (!read_file(STATS_SNAPSHOT_PATH, bytes) || bytes.size() < 16) return false;
+    if (memcmp(bytes.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) return false;
+    
+    ByteReader crc_reader(bytes, bytes.size() - 4);
+    if (crc_reader.u32() != crc32(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size() - 4)) {
+        return false;
+    }
+    
+    ByteReader in(bytes, sizeof(SNAPSHOT_MAGIC));
+    if (in.u32() != STATS_JOURNAL_VERSION) return false;
+    covered = in.u64();
+    stats.games_played = static_cast<int>(in.u32());
+    stats.high_score = static_cast<int>(in.u32());
+    stats.max_level = static_cast<int>(in.u32());
+    stats.max_length = static_cast<int>(in.u32());
+    stats.total_score = static_cast<long long>(in.u64());
+    stats.total_time_played = in.u32();
+    stats.total_foods_eaten = static_cast<int>(in.u32());
+    stats.special_foods_eaten = static_cast<int>(in.u32());
+    stats.max_combo = static_cast<int>(in.u32());
+    uint32_t count = in.u32();
+    unlocked.clear();
+    for (uint32_t i = 0; i < count && in.ok; i++) {
+        unlocked.push_back(in.u32());
+    }
+    return in.ok && in.pos == bytes.size() - 4;
+}
+
+StatsJournal::StatsJournal() : writer(nullptr), journal_size(0), records_since_snapshot(0) {
+}
+
+bool StatsJournal::load(GameStats& stats, std::vector<uint32_t>& unlocked) {
+    stats.clear();
+    unlocked.clear();
+    
+    uint64_t covered = JOURNAL_HEADER_SIZE;
+    bool has_snapshot = load_snapshot(stats, unlocked, covered);
+    if (!has_snapshot) {
+        stats.clear();
+        unlocked.clear();
+        covered = JOURNAL_HEADER_SIZE;
+    }
+    
+    // Only the tail past the snapshot is read
+    std::ifstream file(STATS_JOURNAL_PATH, std::ios::binary);
+    bool has_journal = file.is_open();
+    std::string header(JOURNAL_HEADER_SIZE, '\0');
+    if (has_journal) {
+        file.read(&header[0], JOURNAL_HEADER_SIZE);
+        ByteReader version(header, sizeof(JOURNAL_MAGIC));
+        if (!file || memcmp(header.data(), JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+            version.u32() != STATS_JOURNAL_VERSION) {
+            std::cerr << "Warning: " << STATS_JOURNAL_PATH << " is unreadable, starting a new one" << std::endl;
+            has_journal = false;
+        }
+    }
+    
+    std::string tail;
+    bool tail_in_range = false;
+    if (has_journal) {
+        file.seekg(0, std::ios::end);
+        uint64_t file_size = static_cast<uint64_t>(file.tellg());
+        tail_in_range = covered <= file_size;
+        if (tail_in_range) {
+            file.seekg(static_cast<std::streamoff>(covered));
+            tail.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+    }
+    file.close();
+    
+    // Records up to the first torn or corrupt one
+    size_t pos = 0;
+    while (tail.size() - pos >= RECORD_OVERHEAD) {
+        const unsigned char* record = reinterpret_cast<const unsigned char*>(tail.data()) + pos;
+        size_t payload_size = record[1];
+        size_t record_size = RECORD_OVERHEAD + payload_size;
+        if (tail.size() - pos < record_size) break;
+        
+        ByteReader stored_crc(tail, pos + 2 + payload_size);
+        if (stored_crc.u32() != crc32(record, 2 + payload_size)) break;
+        
+        ByteReader payload(tail, pos + 2, pos + 2 + payload_size);
+        apply_record(record[0], payload, stats, unlocked);
+        pos += record_size;
+        records_since_snapshot++;
+    }
+    
+    if (!has_journal) {
+        journal_size = 0;
+        if (access(STATS_JOURNAL_PATH, F_OK) == 0) unlink(STATS_JOURNAL_PATH);
+    } else if (!tail_in_range) {
+        // The snapshot is ahead of the journal; start both over from the totals
+        unlink(STATS_JOURNAL_PATH);
+        journal_size = 0;
+    } else {
+        journal_size = covered + pos;
+        if (pos < tail.size()) {
+            std::cerr << "Warning: Dropping " << (tail.size() - pos) << " damaged bytes from "
+                      << STATS_JOURNAL_PATH << std::endl;
+            if (truncate(STATS_JOURNAL_PATH, static_cast<off_t>(journal_size)) != 0) {
+                std::cerr << "Warning: Could not repair " << STATS_JOURNAL_PATH << std::endl;
+            }
+        }
+    }
+    
+    if (has_snapshot && journal_size == 0) checkpoint(stats, unlocked, true);
+    return has_snapshot || has_journal;
+}
+
+// Starts the file with its header when the journal is new
+void StatsJournal::append_bytes(const std::string& record) {
+    std::string bytes;
+    if (journal_size == 0) {
+        bytes.assign(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+        put_u32(bytes, STATS_JOURNAL_VERSION);
+    }
+    bytes += record;
+    if (bytes.empty()) return;
+    
+    if (writer) {
+        writer->append(STATS_JOURNAL_PATH, bytes);
+    } else {
+        SaveWriter::append_file(STATS_JOURNAL_PATH, bytes);
+    }
+    journal_size += bytes.size();
+}
+
+void StatsJournal::append(JournalRecordType type, const std::string& payload) {
+    std::string record;
+    record.push_back(static_cast<char>(type));
+    record.push_back(static_cast<char>(payload.size()));
+    record += payload;
+    put_u32(record, crc32(record));
+    
+    append_bytes(record);
+    records_since_snapshot++;
+}
+
+void StatsJournal::append_game(const GameRecord& record) {
+    std::string payload;
+    put_u32(payload, record.score);
+    put_u32(payload, record.level);
+    put_u32(payload, record.length);
+    put_u32(payload, record.foods_eaten);
+    put_u32(payload, record.special_foods);
+    put_u32(payload, record.max_combo);
+    put_u32(payload, record.duration_ms);
+    append(JOURNAL_GAME, payload);
+}
+
+void StatsJournal::append_unlock(uint32_t achievement_id) {
+    std::string payload;
+    put_u32(payload, achievement_id);
+    append(JOURNAL_UNLOCK, payload);
+}
+
+void StatsJournal::append_reset() {
+    append(JOURNAL_RESET, std::string());
+}
+
+void StatsJournal::checkpoint(const GameStats& stats, const std::vector<uint32_t>& unlocked, bool force) {
+    if (!force && records_since_snapshot < STATS_SNAPSHOT_INTERVAL) return;
+    
+    // A snapshot must point into a journal that exists
+    if (journal_size == 0) append_bytes(std::string());
+    
+    std::string bytes(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    put_u32(bytes, STATS_JOURNAL_VERSION);
+    put_u64(bytes, journal_size);
+    put_u32(bytes, static_cast<uint32_t>(stats.games_played));
+    put_u32(bytes, static_cast<uint32_t>(stats.high_score));
+    put_u32(bytes, static_cast<uint32_t>(stats.max_level));
+    put_u32(bytes, static_cast<uint32_t>(stats.max_length));
+    put_u64(bytes, static_cast<uint64_t>(stats.total_score));
+    put_u32(bytes, stats.total_time_played);
+    put_u32(bytes, static_cast<uint32_t>(stats.total_foods_eaten));
+    put_u32(bytes, static_cast<uint32_t>(stats.special_foods_eaten));
+    put_u32(bytes, static_cast<uint32_t>(stats.max_combo));
+    put_u32(bytes, static_cast<uint32_t>(unlocked.size()));
+    for (uint32_t id : unlocked) {
+        put_u32(bytes, id);
+    }
+    put_u32(bytes, crc32(bytes));
+    
+    if (writer) {
+        writer->write(STATS_SNAPSHOT_PATH, bytes);
+    } else {
+        SaveWriter::write_file(STATS_SNAPSHOT_PATH, bytes);
+    }
+    records_since_snapshot = 0;
+}
+
+uint32_t StatsJournal::make_id(const std::string& key) {
+    uint32_t hash = 2166136261u;  // FNV-1a
+    for (char c : key) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return hash;
+}
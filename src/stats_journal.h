@@ -0,0 +1,74 @@
+#ifndef STATS_JOURNAL_H
+#define STATS_JOURNAL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class SaveWriter;
+struct GameStats;
+
+// Binary history of finished games and achievement unlocks, replacing the
+// game_stats.dat / achievements.dat text files. Every record is appended
+// with its own CRC32; a torn or corrupt tail is dropped at load. The totals
+// are snapshotted every STATS_SNAPSHOT_INTERVAL records, so startup reads
+// one small snapshot plus at most that many records however many games
+// were played.
+//
+// Journal:  "SNKJRN1\0", u32 version, then records of
+//           u8 type, u8 payload size, payload, u32 CRC of the three
+// Snapshot: "SNKSNP1\0", u32 version, u64 journal size it covers, the
+//           GameStats totals, u32 count + unlocked achievement ids, u32 CRC
+// All integers little-endian.
+const char* const STATS_JOURNAL_PATH = "stats.journal";
+const char* const STATS_SNAPSHOT_PATH = "stats.snapshot";
+const uint32_t STATS_JOURNAL_VERSION = 1;
+const int STATS_SNAPSHOT_INTERVAL = 64;
+
+enum JournalRecordType {
+    JOURNAL_GAME = 1,     // GameRecord
+    JOURNAL_UNLOCK = 2,   // u32 achievement id
+    JOURNAL_RESET = 3     // Totals cleared; unlocks are kept
+};
+
+// One finished game, as folded into the totals
+struct GameRecord {
+    uint32_t score;
+    uint32_t level;
+    uint32_t length;
+    uint32_t foods_eaten;
+    uint32_t special_foods;
+    uint32_t max_combo;
+    uint32_t duration_ms;
+};
+
+class StatsJournal {
+private:
+    SaveWriter* writer;
+    uint64_t journal_size;        // Valid bytes, including queued appends
+    int records_since_snapshot;
+    
+    void append_bytes(const std::string& record);
+    void append(JournalRecordType type, const std::string& payload);
+    
+public:
+    StatsJournal();
+    
+    void set_save_writer(SaveWriter* save_writer) { writer = save_writer; }
+    
+    // Snapshot plus journal tail into stats and unlocked; false when there
+    // is no journal or snapshot yet
+    bool load(GameStats& stats, std::vector<uint32_t>& unlocked);
+    
+    void append_game(const GameRecord& record);
+    void append_unlock(uint32_t achievement_id);
+    void append_reset();
+    
+    // Snapshot of the totals once enough records have piled up, or now
+    void checkpoint(const GameStats& stats, const std::vector<uint32_t>& unlocked, bool force = false);
+    
+    // Stable achievement id from its key; unaffected by list order
+    static uint32_t make_id(const std::string& key);
+};
+
+#endif // STATS_JOURNAL_H
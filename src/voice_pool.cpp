@@ -0,0 +1,107 @@
+#include "voice_pool.h"
+#include <algorithm>
+
+VoicePool::VoicePool()
+    : frame_bytes(0), frequency(0), pending_request(0),
+      latency_last(0), latency_max(0), latency_samples(0), latency_total(0) {
+}
+
+VoicePool::~VoicePool() {
+    close();
+}
+
+bool VoicePool::open(int voice_count) {
+    int channels = 0;
+    Uint16 format = 0;
+    if (voice_count <= 0 || Mix_QuerySpec(&frequency, &format, &channels) == 0) return false;
+    
+    frame_bytes = SDL_AUDIO_BITSIZE(format) / 8 * channels;
+    Mix_AllocateChannels(voice_count);
+    Voice idle = {nullptr, SOUND_PRIORITY_LOW, 0};
+    voices.assign(voice_count, idle);
+    
+    Mix_SetPostMix(post_mix, this);
+    return true;
+}
+
+void VoicePool::close() {
+    if (voices.empty()) return;
+    
+    Mix_SetPostMix(nullptr, nullptr);
+    Mix_HaltChannel(-1);
+    voices.clear();
+}
+
+void VoicePool::set_volumes(int master, int sfx, int music) {
+    master = std::max(0, std::min(MIX_MAX_VOLUME, master));
+    sfx = std::max(0, std::min(MIX_MAX_VOLUME, sfx));
+    music = std::max(0, std::min(MIX_MAX_VOLUME, music));
+    
+    Mix_Volume(-1, master * sfx / MIX_MAX_VOLUME);
+    Mix_VolumeMusic(master * music / MIX_MAX_VOLUME);
+}
+
+int VoicePool::play(Mix_Chunk* chunk, SoundPriority priority) {
+    if (!chunk || voices.empty()) return -1;
+    
+    // A free voice, otherwise the least important sound, oldest first
+    int channel = -1;
+    for (size_t i = 0; i < voices.size(); i++) {
+        if (!Mix_Playing(static_cast<int>(i))) {
+            channel = static_cast<int>(i);
+            break;
+        }
+        if (voices[i].priority > priority) continue;
+        if (channel < 0 || voices[i].priority < voices[channel].priority ||
+            (voices[i].priority == voices[channel].priority &&
+             static_cast<Sint32>(voices[i].started - voices[channel].started) < 0)) {
+            channel = static_cast<int>(i);
+        }
+    }
+    if (channel < 0) return -1;
+    
+    Mix_HaltChannel(channel);
+    
+    // The audio lock keeps the callback out until the chunk is queued and
+    // the request is stored, so the next post-mix buffer is one that holds it
+    Uint64 requested = SDL_GetPerformanceCounter();
+    SDL_LockAudio();
+    bool started = Mix_PlayChannel(channel, chunk, 0) >= 0;
+    if (started) pending_request.store(requested, std::memory_order_relaxed);
+    SDL_UnlockAudio();
+    if (!started) return -1;
+    
+    Voice voice = {chunk, priority, SDL_GetTicks()};
+    voices[channel] = voice;
+    return channel;
+}
+
+// Runs on the audio thread, under the audio lock, after every buffer is
+// mixed. play() stores a request only while holding that lock with the
+// chunk already queued, so the first buffer to see it contains the chunk.
+void VoicePool::post_mix(void* data, Uint8* stream, int length) {
+    (void)stream;
+    VoicePool* pool = static_cast<VoicePool*>(data);
+    Uint64 requested = pool->pending_request.exchange(0, std::memory_order_relaxed);
+    if (requested == 0 || pool->frame_bytes <= 0 || pool->frequency <= 0) return;
+    
+    Uint64 waited = (SDL_GetPerformanceCounter() - requested) * 1000000 / SDL_GetPerformanceFrequency();
+    Uint64 buffered = static_cast<Uint64>(length / pool->frame_bytes) * 1000000 / pool->frequency;
+    Uint32 latency = static_cast<Uint32>(waited + buffered);
+    
+    pool->latency_last.store(latency, std::memory_order_relaxed);
+    if (latency > pool->latency_max.load(std::memory_order_relaxed)) {
+        pool->latency_max.store(latency, std::memory_order_relaxed);
+    }
+    pool->latency_total.fetch_add(latency, std::memory_order_relaxed);
+    pool->latency_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+AudioLatencyStats VoicePool::get_latency() const {
+    AudioLatencyStats stats;
+    stats.last = latency_last.load(std::memory_order_relaxed);
+    stats.max = latency_max.load(std::memory_order_relaxed);
+    stats.samples = latency_samples.load(std::memory_order_relaxed);
+    stats.total = latency_total.load(std::memory_order_relaxed);
+    return stats;
+}
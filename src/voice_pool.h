@@ -0,0 +1,71 @@
+#ifndef VOICE_POOL_H
+#define VOICE_POOL_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <vector>
+
+// Who wins when every voice is busy: a sound only steals a voice playing
+// something of the same or lower priority
+enum SoundPriority {
+    SOUND_PRIORITY_LOW,       // Turn clicks, fired many times a second
+    SOUND_PRIORITY_NORMAL,    // Eating, level ups
+    SOUND_PRIORITY_HIGH       // Game over
+};
+
+// Time from play() until the sound's first buffer was mixed, plus that
+// buffer's own length at the device, in microseconds
+struct AudioLatencyStats {
+    Uint32 last;
+    Uint32 max;
+    Uint32 samples;
+    Uint64 total;
+    
+    AudioLatencyStats() : last(0), max(0), samples(0), total(0) {}
+    float get_average() const { return samples ? static_cast<float>(total) / samples : 0.0f; }
+};
+
+// Sound effects played on a fixed set of mixer channels instead of
+// hard-coded ones, so rapid sounds overlap instead of cutting each other
+// off. When all voices are busy the lowest priority, oldest one is stolen.
+// A post-mix hook on the audio thread timestamps the first buffer mixed
+// after each play() to measure event-to-audio latency.
+class VoicePool {
+private:
+    struct Voice {
+        Mix_Chunk* chunk;
+        SoundPriority priority;
+        Uint32 started;
+    };
+    
+    std::vector<Voice> voices;
+    int frame_bytes;          // One sample frame in the device format
+    int frequency;
+    
+    // Written by play() on the main thread, consumed by the audio thread
+    std::atomic<Uint64> pending_request;
+    std::atomic<Uint32> latency_last, latency_max, latency_samples;
+    std::atomic<Uint64> latency_total;
+    
+    static void post_mix(void* data, Uint8* stream, int length);
+    
+public:
+    VoicePool();
+    ~VoicePool();
+    
+    // After Mix_OpenAudio: reserves voice_count channels and hooks the mixer
+    bool open(int voice_count);
+    void close();
+    bool is_open() const { return !voices.empty(); }
+    
+    // Volumes are 0-128; master scales both the others
+    void set_volumes(int master, int sfx, int music);
+    
+    // Channel the chunk started on, -1 when nothing could be stolen
+    int play(Mix_Chunk* chunk, SoundPriority priority);
+    
+    AudioLatencyStats get_latency() const;
+};
+
+#endif // VOICE_POOL_H
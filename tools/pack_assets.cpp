@@ -0,0 +1,224 @@
+// Asset packer: decodes images and sounds once and writes them, with the
+// raw bytes of music and fonts, into one archive the game memory-maps at
+// startup (see src/asset_archive.h).
+//
+// Build and run with: make pack
+// Usage: pack_assets <output.pak> <file or directory>...
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "asset_archive.h"
+
+struct PackedAsset {
+    std::string path;
+    PakEntry entry;
+    std::vector<uint8_t> data;
+};
+
+static void collect_files(const std::string& path, std::vector<std::string>& files) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return;
+    
+    if (!S_ISDIR(info.st_mode)) {
+        files.push_back(path);
+        return;
+    }
+    
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return;
+    while (struct dirent* item = readdir(dir)) {
+        if (item->d_name[0] == '.') continue;
+        collect_files(path + "/" + item->d_name, files);
+    }
+    closedir(dir);
+}
+
+static std::string get_extension(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return "";
+    std::string extension = path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension;
+}
+
+static bool read_file(const std::string& path, std::vector<uint8_t>& data) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data.resize(size > 0 ? size : 0);
+    bool ok = size >= 0 && fread(data.data(), 1, data.size(), file) == data.size();
+    fclose(file);
+    return ok;
+}
+
+static bool pack_image(PackedAsset& asset) {
+    SDL_Surface* loaded = IMG_Load(asset.path.c_str());
+    if (!loaded) return false;
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, PAK_PIXEL_FORMAT, 0);
+    SDL_FreeSurface(loaded);
+    if (!surface) return false;
+    
+    // Rows are stored tightly packed
+    uint32_t row_bytes = surface->w * 4;
+    asset.entry.kind = PAK_IMAGE;
+    asset.entry.width = surface->w;
+    asset.entry.height = surface->h;
+    asset.entry.pitch = row_bytes;
+    asset.data.resize(static_cast<size_t>(row_bytes) * surface->h);
+    
+    SDL_LockSurface(surface);
+    for (int y = 0; y < surface->h; y++) {
+        memcpy(&asset.data[static_cast<size_t>(y) * row_bytes],
+               static_cast<const uint8_t*>(surface->pixels) + y * surface->pitch, row_bytes);
+    }
+    SDL_UnlockSurface(surface);
+    SDL_FreeSurface(surface);
+    return true;
+}
+
+static bool pack_sound(PackedAsset& asset) {
+    // Mix_LoadWAV converts to the opened device format
+    Mix_Chunk* chunk = Mix_LoadWAV(asset.path.c_str());
+    if (!chunk) return false;
+    
+    asset.entry.kind = PAK_SOUND;
+    asset.data.assign(chunk->abuf, chunk->abuf + chunk->alen);
+    Mix_FreeChunk(chunk);
+    return true;
+}
+
+static size_t align(size_t offset) {
+    return (offset + PAK_ALIGNMENT - 1) & ~(PAK_ALIGNMENT - 1);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <output.pak> <file or directory>...\n", argv[0]);
+        return 1;
+    }
+    
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        fprintf(stderr, "SDL_Init: %s\n", SDL_GetError());
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+    
+    // Same parameters as Game::load_audio(); the game checks them on load
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+        fprintf(stderr, "Mix_OpenAudio: %s (try SDL_AUDIODRIVER=dummy)\n", Mix_GetError());
+        return 1;
+    }
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    Mix_QuerySpec(&frequency, &format, &channels);
+    
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; i++) {
+        collect_files(argv[i], files);
+    }
+    std::sort(files.begin(), files.end());
+    
+    std::vector<PackedAsset> assets;
+    int counts[4] = {0, 0, 0, 0};
+    for (const std::string& path : files) {
+        PackedAsset asset;
+        asset.path = path;
+        memset(&asset.entry, 0, sizeof(asset.entry));
+        asset.entry.hash = AssetArchive::hash_path(path);
+        
+        std::string extension = get_extension(path);
+        bool ok;
+        if (extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "bmp") {
+            ok = pack_image(asset);
+        } else if (extension == "wav") {
+            ok = pack_sound(asset);
+        } else if (extension == "mp3" || extension == "ogg" || extension == "ttf") {
+            asset.entry.kind = PAK_RAW;
+            ok = read_file(path, asset.data);
+        } else {
+            continue;
+        }
+        
+        if (!ok) {
+            fprintf(stderr, "Skipping %s: %s\n", path.c_str(), SDL_GetError());
+            continue;
+        }
+        counts[asset.entry.kind]++;
+        assets.push_back(asset);
+    }
+    
+    // Open-addressing table at most half full
+    uint32_t table_size = 16;
+    while (table_size < assets.size() * 2) table_size *= 2;
+    std::vector<PakEntry> table(table_size);
+    memset(table.data(), 0, table.size() * sizeof(PakEntry));
+    
+    size_t offset = align(sizeof(PakHeader) + table.size() * sizeof(PakEntry));
+    for (PackedAsset& asset : assets) {
+        asset.entry.offset = offset;
+        asset.entry.size = asset.data.size();
+        offset = align(offset + asset.data.size());
+        
+        // Hash 0 marks an empty slot; hash_path() never returns it, but an
+        // entry written with it would be unreachable
+        if (asset.entry.hash == 0) {
+            fprintf(stderr, "Zero hash for %s\n", asset.path.c_str());
+            return 1;
+        }
+        
+        uint32_t slot = static_cast<uint32_t>(asset.entry.hash) & (table_size - 1);
+        while (table[slot].hash != 0) {
+            if (table[slot].hash == asset.entry.hash) {
+                fprintf(stderr, "Hash collision on %s\n", asset.path.c_str());
+                return 1;
+            }
+            slot = (slot + 1) & (table_size - 1);
+        }
+        table[slot] = asset.entry;
+    }
+    
+    PakHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PAK_MAGIC, sizeof(PAK_MAGIC));
+    header.version = PAK_VERSION;
+    header.table_size = table_size;
+    header.entry_count = static_cast<uint32_t>(assets.size());
+    header.pixel_format = PAK_PIXEL_FORMAT;
+    header.audio_frequency = frequency;
+    header.audio_format = format;
+    header.audio_channels = static_cast<uint16_t>(channels);
+    
+    FILE* out = fopen(argv[1], "wb");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", argv[1]);
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, out);
+    fwrite(table.data(), sizeof(PakEntry), table.size(), out);
+    for (const PackedAsset& asset : assets) {
+        fseek(out, static_cast<long>(asset.entry.offset), SEEK_SET);
+        fwrite(asset.data.data(), 1, asset.data.size(), out);
+    }
+    fclose(out);
+    
+    printf("📦 %s: %d images, %d sounds, %d raw files, %.1f MB\n", argv[1],
+           counts[PAK_IMAGE], counts[PAK_SOUND], counts[PAK_RAW], offset / (1024.0 * 1024.0));
+    
+    Mix_CloseAudio();
+    IMG_Quit();
+    SDL_Quit();
+    return 0;
+}